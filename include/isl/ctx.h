@@ -70,6 +70,13 @@ extern "C" {
  */
 struct isl_stats {
 	long	gbr_solved_lps;
+	long	simplify_calls;
+	long	simplify_skipped;
+	long	simple_hull_lps;
+	long	simple_hull_box_bounds;
+	long	closure_cache_hits;
+	long	closure_cache_misses;
+	long	tab_pivots;
 };
 enum isl_error {
 	isl_error_none = 0,
@@ -170,6 +177,10 @@ int isl_ctx_aborted(isl_ctx *ctx);
 void isl_ctx_set_max_operations(isl_ctx *ctx, unsigned long max_operations);
 unsigned long isl_ctx_get_max_operations(isl_ctx *ctx);
 void isl_ctx_reset_operations(isl_ctx *ctx);
+void isl_ctx_set_deadline(isl_ctx *ctx, unsigned long timeout);
+
+isl_stat isl_ctx_run_tasks(isl_ctx *ctx, int n,
+	isl_stat (*fn)(isl_ctx *ctx, int pos, void *user), void *user);
 
 #define ISL_ARG_CTX_DECL(prefix,st,args)				\
 st *isl_ctx_peek_ ## prefix(isl_ctx *ctx);
@@ -43,6 +43,12 @@ int isl_options_get_schedule_algorithm(isl_ctx *ctx);
 isl_stat isl_options_set_coalesce_bounded_wrapping(isl_ctx *ctx, int val);
 int isl_options_get_coalesce_bounded_wrapping(isl_ctx *ctx);
 
+isl_stat isl_options_set_closure_cache_size(isl_ctx *ctx, int val);
+int isl_options_get_closure_cache_size(isl_ctx *ctx);
+
+isl_stat isl_options_set_thread_pool_size(isl_ctx *ctx, int val);
+int isl_options_get_thread_pool_size(isl_ctx *ctx);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -14,9 +14,6 @@
 extern "C" {
 #endif
 
-struct isl_schedule_constraints;
-typedef struct isl_schedule_constraints isl_schedule_constraints;
-
 isl_stat isl_options_set_schedule_max_coefficient(isl_ctx *ctx, int val);
 int isl_options_get_schedule_max_coefficient(isl_ctx *ctx);
 
@@ -47,6 +44,19 @@ int isl_options_get_schedule_serialize_sccs(isl_ctx *ctx);
 isl_stat isl_options_set_schedule_whole_component(isl_ctx *ctx, int val);
 int isl_options_get_schedule_whole_component(isl_ctx *ctx);
 
+isl_stat isl_options_set_schedule_concurrent_components(isl_ctx *ctx,
+	int val);
+int isl_options_get_schedule_concurrent_components(isl_ctx *ctx);
+
+isl_stat isl_options_set_schedule_concurrent_merge(isl_ctx *ctx, int val);
+int isl_options_get_schedule_concurrent_merge(isl_ctx *ctx);
+
+isl_stat isl_options_set_schedule_budget(isl_ctx *ctx, int val);
+int isl_options_get_schedule_budget(isl_ctx *ctx);
+
+isl_stat isl_options_set_schedule_max_generators(isl_ctx *ctx, int val);
+int isl_options_get_schedule_max_generators(isl_ctx *ctx);
+
 __isl_give isl_schedule_constraints *isl_schedule_constraints_copy(
 	__isl_keep isl_schedule_constraints *sc);
 __isl_give isl_schedule_constraints *isl_schedule_constraints_on_domain(
@@ -90,10 +100,22 @@ __isl_give isl_schedule_constraints *isl_schedule_constraints_apply(
 	__isl_take isl_schedule_constraints *sc,
 	__isl_take isl_union_map *umap);
 
+__isl_give isl_schedule_constraints *isl_schedule_constraints_read_from_file(
+	isl_ctx *ctx, FILE *input);
+__isl_give isl_schedule_constraints *isl_schedule_constraints_read_from_str(
+	isl_ctx *ctx, const char *str);
+__isl_give isl_printer *isl_printer_print_schedule_constraints(
+	__isl_take isl_printer *p, __isl_keep isl_schedule_constraints *sc);
 void isl_schedule_constraints_dump(__isl_keep isl_schedule_constraints *sc);
+__isl_give char *isl_schedule_constraints_to_str(
+	__isl_keep isl_schedule_constraints *sc);
 
 __isl_give isl_schedule *isl_schedule_constraints_compute_schedule(
 	__isl_take isl_schedule_constraints *sc);
+__isl_give isl_schedule *isl_schedule_constraints_recompute_schedule(
+	__isl_take isl_schedule_constraints *sc,
+	__isl_take isl_schedule *schedule);
+__isl_give char *isl_ctx_schedule_stats_to_str(isl_ctx *ctx);
 
 __isl_give isl_schedule *isl_union_set_compute_schedule(
 	__isl_take isl_union_set *domain,
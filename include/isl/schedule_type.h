@@ -26,6 +26,9 @@ typedef struct isl_schedule_node isl_schedule_node;
 struct __isl_export isl_schedule;
 typedef struct isl_schedule isl_schedule;
 
+struct isl_schedule_constraints;
+typedef struct isl_schedule_constraints isl_schedule_constraints;
+
 #if defined(__cplusplus)
 }
 #endif
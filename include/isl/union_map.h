@@ -24,9 +24,13 @@ __isl_give isl_union_map *isl_union_map_from_basic_map(
 	__isl_take isl_basic_map *bmap);
 __isl_constructor
 __isl_give isl_union_map *isl_union_map_from_map(__isl_take isl_map *map);
+__isl_give isl_union_map *isl_union_map_from_map_list(
+	__isl_take isl_map_list *list);
 __isl_give isl_union_map *isl_union_map_empty(__isl_take isl_space *dim);
 __isl_give isl_union_map *isl_union_map_copy(__isl_keep isl_union_map *umap);
 __isl_null isl_union_map *isl_union_map_free(__isl_take isl_union_map *umap);
+__isl_give isl_union_map *isl_union_map_transfer(
+	__isl_take isl_union_map *umap, isl_ctx *ctx);
 
 isl_ctx *isl_union_map_get_ctx(__isl_keep isl_union_map *umap);
 __isl_give isl_space *isl_union_map_get_space(__isl_keep isl_union_map *umap);
@@ -16,9 +16,13 @@ __isl_give isl_union_set *isl_union_set_from_basic_set(
 	__isl_take isl_basic_set *bset);
 __isl_constructor
 __isl_give isl_union_set *isl_union_set_from_set(__isl_take isl_set *set);
+__isl_give isl_union_set *isl_union_set_from_set_list(
+	__isl_take isl_set_list *list);
 __isl_give isl_union_set *isl_union_set_empty(__isl_take isl_space *dim);
 __isl_give isl_union_set *isl_union_set_copy(__isl_keep isl_union_set *uset);
 __isl_null isl_union_set *isl_union_set_free(__isl_take isl_union_set *uset);
+__isl_give isl_union_set *isl_union_set_transfer(
+	__isl_take isl_union_set *uset, isl_ctx *ctx);
 
 isl_ctx *isl_union_set_get_ctx(__isl_keep isl_union_set *uset);
 __isl_give isl_space *isl_union_set_get_space(__isl_keep isl_union_set *uset);
@@ -99,6 +99,26 @@ error:
 	return NULL;
 }
 
+/* Return a copy of "aff" that lives in "ctx".
+ * The local space and the coefficients of "aff" are only read,
+ * such that none of the reference counts of the components of "aff"
+ * is affected.
+ */
+static __isl_give isl_aff *aff_dup_to_ctx(__isl_keep isl_aff *aff,
+	isl_ctx *ctx)
+{
+	isl_space *space;
+	isl_local_space *ls;
+
+	if (!aff)
+		return NULL;
+
+	space = isl_space_transfer(isl_space_copy(aff->ls->dim), ctx);
+	ls = isl_local_space_alloc_div(space,
+				isl_mat_dup_to_ctx(aff->ls->div, ctx));
+	return isl_aff_alloc_vec(ls, isl_vec_dup_to_ctx(aff->v, ctx));
+}
+
 __isl_give isl_aff *isl_aff_zero_on_domain(__isl_take isl_local_space *ls)
 {
 	isl_aff *aff;
@@ -2620,6 +2640,76 @@ __isl_give isl_pw_aff *isl_pw_aff_from_aff(__isl_take isl_aff *aff)
 #include <isl_union_single.c>
 #include <isl_union_neg.c>
 
+/* Return a copy of "pa" that lives in "ctx".
+ */
+static __isl_give isl_pw_aff *pw_aff_dup_to_ctx(__isl_keep isl_pw_aff *pa,
+	isl_ctx *ctx)
+{
+	int i;
+	isl_space *space;
+	isl_pw_aff *res;
+
+	if (!pa)
+		return NULL;
+
+	space = isl_space_transfer(isl_space_copy(pa->dim), ctx);
+	res = isl_pw_aff_alloc_size(space, pa->n);
+	for (i = 0; i < pa->n; ++i) {
+		isl_set *set;
+		isl_aff *aff;
+
+		set = isl_set_transfer(isl_set_copy(pa->p[i].set), ctx);
+		aff = aff_dup_to_ctx(pa->p[i].aff, ctx);
+		res = isl_pw_aff_add_piece(res, set, aff);
+	}
+
+	return res;
+}
+
+/* Data structure for union_pw_aff_dup_to_ctx.
+ *
+ * "ctx" is the target context and "res" collects the copied
+ * piecewise affine expressions.
+ */
+struct isl_union_pw_aff_transfer_data {
+	isl_ctx *ctx;
+	isl_union_pw_aff *res;
+};
+
+/* Add a copy of the piecewise affine expression in "entry"
+ * that lives in data->ctx to data->res.
+ */
+static isl_stat union_pw_aff_transfer_entry(void **entry, void *user)
+{
+	struct isl_union_pw_aff_transfer_data *data = user;
+	isl_pw_aff *pa = *entry;
+
+	pa = pw_aff_dup_to_ctx(pa, data->ctx);
+	data->res = isl_union_pw_aff_add_pw_aff(data->res, pa);
+
+	return data->res ? isl_stat_ok : isl_stat_error;
+}
+
+/* Return a copy of "upa" that lives in "ctx".
+ */
+static __isl_give isl_union_pw_aff *union_pw_aff_dup_to_ctx(
+	__isl_keep isl_union_pw_aff *upa, isl_ctx *ctx)
+{
+	isl_space *space;
+	struct isl_union_pw_aff_transfer_data data = { ctx };
+
+	if (!upa)
+		return NULL;
+
+	space = isl_space_transfer(isl_space_copy(upa->space), ctx);
+	data.res = isl_union_pw_aff_alloc(space, upa->table.n);
+	if (isl_union_pw_aff_foreach_inplace(upa,
+				&union_pw_aff_transfer_entry, &data) < 0)
+		data.res = isl_union_pw_aff_free(data.res);
+
+	return data.res;
+}
+
 static __isl_give isl_set *align_params_pw_pw_set_and(
 	__isl_take isl_pw_aff *pwaff1, __isl_take isl_pw_aff *pwaff2,
 	__isl_give isl_set *(*fn)(__isl_take isl_pw_aff *pwaff1,
@@ -3739,6 +3829,49 @@ error:
 #include <isl_multi_floor.c>
 #include <isl_multi_gist.c>
 
+/* Return a copy of "ma" that lives in "ctx".
+ */
+static __isl_give isl_multi_aff *multi_aff_dup_to_ctx(
+	__isl_keep isl_multi_aff *ma, isl_ctx *ctx)
+{
+	int i;
+	isl_space *space;
+	isl_multi_aff *res;
+
+	if (!ma)
+		return NULL;
+
+	space = isl_space_transfer(isl_space_copy(ma->space), ctx);
+	res = isl_multi_aff_alloc(space);
+	for (i = 0; res && i < ma->n; ++i) {
+		res->p[i] = aff_dup_to_ctx(ma->p[i], ctx);
+		if (!res->p[i])
+			res = isl_multi_aff_free(res);
+	}
+
+	return res;
+}
+
+/* Return a copy of "ma" that lives in "ctx".
+ * The components of "ma" are only read, such that only the reference
+ * count of "ma" itself is affected.
+ * If "ma" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_multi_aff *isl_multi_aff_transfer(__isl_take isl_multi_aff *ma,
+	isl_ctx *ctx)
+{
+	isl_multi_aff *res;
+
+	if (!ma || !ctx)
+		return isl_multi_aff_free(ma);
+	if (isl_multi_aff_get_ctx(ma) == ctx)
+		return ma;
+
+	res = multi_aff_dup_to_ctx(ma, ctx);
+	isl_multi_aff_free(ma);
+	return res;
+}
+
 #undef NO_DOMAIN
 
 /* Remove any internal structure of the domain of "ma".
@@ -4099,6 +4232,80 @@ __isl_give isl_set *isl_multi_aff_lex_gt_set(__isl_take isl_multi_aff *ma1,
 #include <isl_union_multi.c>
 #include <isl_union_neg.c>
 
+/* Return a copy of "pma" that lives in "ctx".
+ */
+static __isl_give isl_pw_multi_aff *pw_multi_aff_dup_to_ctx(
+	__isl_keep isl_pw_multi_aff *pma, isl_ctx *ctx)
+{
+	int i;
+	isl_space *space;
+	isl_pw_multi_aff *res;
+
+	if (!pma)
+		return NULL;
+
+	space = isl_space_transfer(isl_space_copy(pma->dim), ctx);
+	res = isl_pw_multi_aff_alloc_size(space, pma->n);
+	for (i = 0; i < pma->n; ++i) {
+		isl_set *set;
+		isl_multi_aff *ma;
+
+		set = isl_set_transfer(isl_set_copy(pma->p[i].set), ctx);
+		ma = multi_aff_dup_to_ctx(pma->p[i].maff, ctx);
+		res = isl_pw_multi_aff_add_piece(res, set, ma);
+	}
+
+	return res;
+}
+
+/* Data structure for isl_union_pw_multi_aff_transfer.
+ *
+ * "ctx" is the target context and "res" collects the copied
+ * piecewise multi-affine expressions.
+ */
+struct isl_union_pw_multi_aff_transfer_data {
+	isl_ctx *ctx;
+	isl_union_pw_multi_aff *res;
+};
+
+/* Add a copy of the piecewise multi-affine expression in "entry"
+ * that lives in data->ctx to data->res.
+ */
+static isl_stat union_pw_multi_aff_transfer_entry(void **entry, void *user)
+{
+	struct isl_union_pw_multi_aff_transfer_data *data = user;
+	isl_pw_multi_aff *pma = *entry;
+
+	pma = pw_multi_aff_dup_to_ctx(pma, data->ctx);
+	data->res = isl_union_pw_multi_aff_add_pw_multi_aff(data->res, pma);
+
+	return data->res ? isl_stat_ok : isl_stat_error;
+}
+
+/* Return a copy of "upma" that lives in "ctx".
+ * If "upma" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_union_pw_multi_aff *isl_union_pw_multi_aff_transfer(
+	__isl_take isl_union_pw_multi_aff *upma, isl_ctx *ctx)
+{
+	isl_space *space;
+	struct isl_union_pw_multi_aff_transfer_data data = { ctx };
+
+	if (!upma || !ctx)
+		return isl_union_pw_multi_aff_free(upma);
+	if (isl_union_pw_multi_aff_get_ctx(upma) == ctx)
+		return upma;
+
+	space = isl_space_transfer(isl_space_copy(upma->space), ctx);
+	data.res = isl_union_pw_multi_aff_alloc(space, upma->table.n);
+	if (isl_union_pw_multi_aff_foreach_inplace(upma,
+			    &union_pw_multi_aff_transfer_entry, &data) < 0)
+		data.res = isl_union_pw_multi_aff_free(data.res);
+
+	isl_union_pw_multi_aff_free(upma);
+	return data.res;
+}
+
 static __isl_give isl_pw_multi_aff *pw_multi_aff_union_lexmax(
 	__isl_take isl_pw_multi_aff *pma1,
 	__isl_take isl_pw_multi_aff *pma2)
@@ -7762,6 +7969,33 @@ error:
 #include <isl_multi_gist.c>
 #include <isl_multi_intersect.c>
 
+/* Return a copy of "mupa" that lives in "ctx".
+ * If "mupa" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_multi_union_pw_aff *isl_multi_union_pw_aff_transfer(
+	__isl_take isl_multi_union_pw_aff *mupa, isl_ctx *ctx)
+{
+	int i;
+	isl_space *space;
+	isl_multi_union_pw_aff *res;
+
+	if (!mupa || !ctx)
+		return isl_multi_union_pw_aff_free(mupa);
+	if (isl_multi_union_pw_aff_get_ctx(mupa) == ctx)
+		return mupa;
+
+	space = isl_space_transfer(isl_space_copy(mupa->space), ctx);
+	res = isl_multi_union_pw_aff_alloc(space);
+	for (i = 0; res && i < mupa->n; ++i) {
+		res->p[i] = union_pw_aff_dup_to_ctx(mupa->p[i], ctx);
+		if (!res->p[i])
+			res = isl_multi_union_pw_aff_free(res);
+	}
+
+	isl_multi_union_pw_aff_free(mupa);
+	return res;
+}
+
 /* Construct a multiple union piecewise affine expression
  * in the given space with value zero in each of the output dimensions.
  *
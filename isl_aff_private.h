@@ -118,6 +118,8 @@ int isl_aff_check_match_domain_space(__isl_keep isl_aff *aff,
 #include <isl_multi_templ.h>
 
 __isl_give isl_multi_aff *isl_multi_aff_dup(__isl_keep isl_multi_aff *multi);
+__isl_give isl_multi_aff *isl_multi_aff_transfer(__isl_take isl_multi_aff *ma,
+	isl_ctx *ctx);
 
 __isl_give isl_multi_aff *isl_multi_aff_align_divs(
 	__isl_take isl_multi_aff *maff);
@@ -169,9 +171,15 @@ int isl_pw_aff_check_match_domain_space(__isl_keep isl_pw_aff *pa,
 
 #include <isl_multi_templ.h>
 
+__isl_give isl_multi_union_pw_aff *isl_multi_union_pw_aff_transfer(
+	__isl_take isl_multi_union_pw_aff *mupa, isl_ctx *ctx);
+
 #undef EL
 #define EL isl_union_pw_multi_aff
 
 #include <isl_list_templ.h>
 
+__isl_give isl_union_pw_multi_aff *isl_union_pw_multi_aff_transfer(
+	__isl_take isl_union_pw_multi_aff *upma, isl_ctx *ctx);
+
 #endif
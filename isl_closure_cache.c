@@ -0,0 +1,327 @@
+/*
+ * Use of this software is governed by the MIT license
+ */
+
+#include <string.h>
+#include <isl_ctx_private.h>
+#include <isl_map_private.h>
+#include <isl_space_private.h>
+#include <isl_options_private.h>
+#include <isl_sort.h>
+#include <isl_closure_cache.h>
+
+/* An entry in the closure cache.
+ *
+ * "key" is the input map with its parameters in the order
+ * imposed by canonicalize_params and "hash" is its hash value.
+ * "op" is the operation that was applied, "want_exact" records
+ * whether the caller asked for exactness information and
+ * "closure" is the value of the closure option at the time.
+ * These all affect the result, which is stored in "res",
+ * with the parameters in the same order as those of "key",
+ * with "exact" the exactness of the result.
+ * "last_use" is the value of the cache clock at the most recent
+ * lookup or insertion of this entry.
+ */
+struct isl_closure_cache_entry {
+	enum isl_closure_cache_op op;
+	int want_exact;
+	unsigned closure;
+	uint32_t hash;
+	isl_map *key;
+	isl_map *res;
+	int exact;
+	unsigned long last_use;
+};
+
+/* A cache of transitive closure and power results.
+ *
+ * "entry" contains "n" entries and has room for "size" entries.
+ * "clock" is incremented on every lookup and insertion and
+ * is used to evict the least recently used entry.
+ */
+struct isl_closure_cache {
+	int n;
+	int size;
+	unsigned long clock;
+	struct isl_closure_cache_entry *entry;
+};
+
+static void clear_entry(struct isl_closure_cache_entry *entry)
+{
+	isl_map_free(entry->key);
+	isl_map_free(entry->res);
+}
+
+void isl_closure_cache_free(struct isl_closure_cache *cache)
+{
+	int i;
+
+	if (!cache)
+		return;
+
+	for (i = 0; i < cache->n; ++i)
+		clear_entry(&cache->entry[i]);
+	free(cache->entry);
+	free(cache);
+}
+
+/* Compare the parameter identifiers pointed to by "a" and "b",
+ * first by name and then by address, to distinguish
+ * different identifiers with the same name.
+ */
+static int cmp_param_id(const void *a, const void *b, void *user)
+{
+	isl_id *const *id1 = a;
+	isl_id *const *id2 = b;
+	const char *name1, *name2;
+	int cmp;
+
+	name1 = isl_id_get_name(*id1);
+	name2 = isl_id_get_name(*id2);
+	cmp = strcmp(name1 ? name1 : "", name2 ? name2 : "");
+	if (cmp)
+		return cmp;
+	if (*id1 == *id2)
+		return 0;
+	return *id1 < *id2 ? -1 : 1;
+}
+
+/* Reorder the parameters of "map" according to cmp_param_id,
+ * such that maps that only differ in the order of their parameters
+ * result in the same key in the cache.
+ * If the parameters are not all named, then they cannot be reordered
+ * and "map" is returned unchanged.  Such a map only matches
+ * maps with the same parameters in the same positions.
+ */
+static __isl_give isl_map *canonicalize_params(__isl_take isl_map *map)
+{
+	int i, n;
+	isl_ctx *ctx;
+	isl_space *space;
+	isl_id **ids;
+
+	if (!map)
+		return NULL;
+	if (!isl_space_has_named_params(map->dim))
+		return map;
+
+	ctx = isl_map_get_ctx(map);
+	n = isl_map_dim(map, isl_dim_param);
+	ids = isl_alloc_array(ctx, isl_id *, n);
+	if (n && !ids)
+		return isl_map_free(map);
+	for (i = 0; i < n; ++i)
+		ids[i] = isl_map_get_dim_id(map, isl_dim_param, i);
+	space = isl_space_params_alloc(ctx, n);
+	if (isl_sort(ids, n, sizeof(isl_id *), &cmp_param_id, NULL) < 0)
+		space = isl_space_free(space);
+	for (i = 0; i < n; ++i)
+		space = isl_space_set_dim_id(space, isl_dim_param, i, ids[i]);
+	free(ids);
+
+	return isl_map_align_params(map, space);
+}
+
+/* Give the parameters of "res", which are those of "map"
+ * in the order imposed by canonicalize_params, the order
+ * of the parameters of "map".
+ */
+static __isl_give isl_map *restore_params(__isl_take isl_map *res,
+	__isl_keep isl_map *map)
+{
+	if (!res || !map)
+		return isl_map_free(res);
+	if (!isl_space_has_named_params(map->dim))
+		return res;
+
+	return isl_map_align_params(res, isl_map_get_space(map));
+}
+
+/* Is the closure cache of "ctx" enabled?
+ */
+static int cache_enabled(isl_ctx *ctx)
+{
+	return ctx->opt->closure_cache_size > 0;
+}
+
+/* Look for a result of applying "op" to "map" in the closure cache
+ * of the context of "map".
+ * "want_exact" is set if the caller is interested in exactness
+ * information, since this affects the computation.
+ * The parameters of "map" are first put in a canonical order,
+ * such that maps that only differ in the order of their parameters
+ * match the same entry, while the identifiers of the parameters
+ * are taken into account in the comparison.
+ * If an entry is found, then the corresponding result is stored
+ * in *res, with the parameters in the order of those of "map",
+ * and its exactness in *exact (if not NULL).
+ */
+isl_bool isl_closure_cache_find(__isl_keep isl_map *map,
+	enum isl_closure_cache_op op, int want_exact,
+	__isl_give isl_map **res, int *exact)
+{
+	int i;
+	isl_ctx *ctx;
+	struct isl_closure_cache *cache;
+	uint32_t hash;
+	isl_map *key;
+
+	if (!map)
+		return isl_bool_error;
+	ctx = isl_map_get_ctx(map);
+	cache = ctx->closure_cache;
+	if (!cache_enabled(ctx))
+		return isl_bool_false;
+	if (!cache || cache->n == 0) {
+		ctx->stats->closure_cache_misses++;
+		return isl_bool_false;
+	}
+
+	key = canonicalize_params(isl_map_copy(map));
+	hash = isl_map_get_hash(key);
+	if (!key)
+		return isl_bool_error;
+
+	for (i = 0; i < cache->n; ++i) {
+		struct isl_closure_cache_entry *entry = &cache->entry[i];
+		isl_bool equal;
+
+		if (entry->hash != hash || entry->op != op ||
+		    entry->want_exact != want_exact ||
+		    entry->closure != ctx->opt->closure)
+			continue;
+		equal = isl_map_plain_is_equal(entry->key, key);
+		if (equal < 0)
+			goto error;
+		if (!equal)
+			continue;
+		isl_map_free(key);
+		entry->last_use = ++cache->clock;
+		ctx->stats->closure_cache_hits++;
+		*res = restore_params(isl_map_copy(entry->res), map);
+		if (exact)
+			*exact = entry->exact;
+		return *res ? isl_bool_true : isl_bool_error;
+	}
+
+	isl_map_free(key);
+	ctx->stats->closure_cache_misses++;
+	return isl_bool_false;
+error:
+	isl_map_free(key);
+	return isl_bool_error;
+}
+
+/* Return the position of the least recently used entry of "cache".
+ */
+static int least_recently_used(struct isl_closure_cache *cache)
+{
+	int i, pos = 0;
+
+	for (i = 1; i < cache->n; ++i)
+		if (cache->entry[i].last_use < cache->entry[pos].last_use)
+			pos = i;
+
+	return pos;
+}
+
+/* Evict the least recently used entries of "cache" until
+ * it contains at most "size" entries.
+ */
+void isl_closure_cache_trim(struct isl_closure_cache *cache, int size)
+{
+	if (!cache)
+		return;
+
+	while (cache->n > 0 && cache->n > size) {
+		int pos = least_recently_used(cache);
+
+		clear_entry(&cache->entry[pos]);
+		cache->entry[pos] = cache->entry[--cache->n];
+	}
+}
+
+/* Make sure "ctx" has a closure cache with room for at least one
+ * more entry, evicting the least recently used entries if the cache
+ * would otherwise grow beyond the closure_cache_size option.
+ * This also takes care of evicting any entries beyond
+ * the closure_cache_size option that remain after the option
+ * has been lowered without going through
+ * isl_options_set_closure_cache_size.
+ * Return the position of the free slot.
+ */
+static int free_slot(isl_ctx *ctx)
+{
+	struct isl_closure_cache *cache;
+	int size = ctx->opt->closure_cache_size;
+
+	if (!ctx->closure_cache) {
+		ctx->closure_cache = isl_calloc_type(ctx,
+						struct isl_closure_cache);
+		if (!ctx->closure_cache)
+			return -1;
+	}
+	cache = ctx->closure_cache;
+
+	isl_closure_cache_trim(cache, size - 1);
+
+	if (cache->n >= cache->size) {
+		struct isl_closure_cache_entry *entry;
+
+		entry = isl_realloc_array(ctx, cache->entry,
+				struct isl_closure_cache_entry, size);
+		if (!entry)
+			return -1;
+		cache->entry = entry;
+		cache->size = size;
+	}
+
+	return cache->n;
+}
+
+/* Store "res" with exactness "exact" as the result of applying "op"
+ * to "map" in the closure cache of the context of "map",
+ * where "want_exact" is set if exactness information was requested.
+ * The parameters of both "map" and "res" are put in a canonical order
+ * such that the entry can be reused for maps that only differ
+ * in the order of the parameters.
+ */
+isl_stat isl_closure_cache_add(__isl_keep isl_map *map,
+	enum isl_closure_cache_op op, int want_exact,
+	__isl_keep isl_map *res, int exact)
+{
+	isl_ctx *ctx;
+	int pos;
+	isl_map *key, *value;
+	struct isl_closure_cache_entry *entry;
+
+	if (!map || !res)
+		return isl_stat_error;
+	ctx = isl_map_get_ctx(map);
+	if (!cache_enabled(ctx))
+		return isl_stat_ok;
+
+	key = canonicalize_params(isl_map_copy(map));
+	value = canonicalize_params(isl_map_copy(res));
+	pos = free_slot(ctx);
+	if (!key || !value || pos < 0)
+		goto error;
+
+	entry = &ctx->closure_cache->entry[pos];
+	entry->key = key;
+	entry->res = value;
+	entry->hash = isl_map_get_hash(key);
+	entry->op = op;
+	entry->want_exact = want_exact;
+	entry->closure = ctx->opt->closure;
+	entry->exact = exact;
+	entry->last_use = ++ctx->closure_cache->clock;
+	ctx->closure_cache->n++;
+
+	return isl_stat_ok;
+error:
+	isl_map_free(key);
+	isl_map_free(value);
+	return isl_stat_error;
+}
@@ -0,0 +1,25 @@
+#ifndef ISL_CLOSURE_CACHE_H
+#define ISL_CLOSURE_CACHE_H
+
+#include <isl/ctx.h>
+#include <isl/map.h>
+
+/* The operations whose results are kept in the closure cache.
+ */
+enum isl_closure_cache_op {
+	isl_closure_cache_transitive_closure,
+	isl_closure_cache_power
+};
+
+struct isl_closure_cache;
+
+isl_bool isl_closure_cache_find(__isl_keep isl_map *map,
+	enum isl_closure_cache_op op, int want_exact,
+	__isl_give isl_map **res, int *exact);
+isl_stat isl_closure_cache_add(__isl_keep isl_map *map,
+	enum isl_closure_cache_op op, int want_exact,
+	__isl_keep isl_map *res, int exact);
+void isl_closure_cache_trim(struct isl_closure_cache *cache, int size);
+void isl_closure_cache_free(struct isl_closure_cache *cache);
+
+#endif
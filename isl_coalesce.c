@@ -15,6 +15,7 @@
  * B.P. 105 - 78153 Le Chesnay, France
  */
 
+#include <isl_ctx_private.h>
 #include "isl_map_private.h"
 #include <isl_seq.h>
 #include <isl/options.h>
@@ -2474,6 +2475,8 @@ static int coalesce_range(isl_ctx *ctx, struct isl_coalesce_info *info,
 	int i, j;
 
 	for (i = end1 - 1; i >= start1; --i) {
+		if (isl_ctx_check_interrupt(ctx) < 0)
+			return -1;
 		if (info[i].removed)
 			continue;
 		for (j = isl_max(i + 1, start2); j < end2; ++j) {
@@ -275,10 +275,59 @@ error:
 	return NULL;
 }
 
+/* Add the "n" constraints "c" of a basic set in "set",
+ * transformed by "T", to "lp" as the constraints of the basic set
+ * in position "pos".  If "eq" is set, then the constraints
+ * are added as equalities.  Otherwise, they are added as inequalities.
+ * Each row of "c" has "dim" = 1 + d elements and its transformation
+ * is the product of this row and "T".
+ */
+static __isl_give isl_basic_set *add_wrap_constraints(
+	__isl_take isl_basic_set *lp, __isl_keep isl_set *set, int pos,
+	isl_int **c, unsigned n, int eq, __isl_keep isl_mat *T)
+{
+	int j, k;
+	unsigned dim, lp_dim;
+	isl_mat *m;
+
+	if (!lp || n == 0)
+		return lp;
+
+	dim = T->n_row;
+	lp_dim = isl_basic_set_n_dim(lp);
+	m = isl_mat_sub_alloc6(set->ctx, c, 0, n, 0, dim);
+	m = isl_mat_product(m, isl_mat_copy(T));
+	if (!m)
+		return isl_basic_set_free(lp);
+
+	for (j = 0; j < n; ++j) {
+		isl_int *row;
+		if (eq) {
+			k = isl_basic_set_alloc_equality(lp);
+			row = k < 0 ? NULL : lp->eq[k];
+		} else {
+			k = isl_basic_set_alloc_inequality(lp);
+			row = k < 0 ? NULL : lp->ineq[k];
+		}
+		if (k < 0)
+			goto error;
+		isl_seq_clr(row, 1 + lp_dim);
+		isl_seq_cpy(row + 1 + dim * pos, m->row[j], dim);
+	}
+
+	isl_mat_free(m);
+	return lp;
+error:
+	isl_mat_free(m);
+	return isl_basic_set_free(lp);
+}
+
 /* Given a union of basic sets, construct the constraints for wrapping
- * a facet around one of its ridges.
- * In particular, if each of n the d-dimensional basic sets i in "set"
- * contains the origin, satisfies the constraints x_1 >= 0 and x_2 >= 0
+ * a facet around one of its ridges, after applying
+ * the transformation "T" to each of the basic sets.
+ * In particular, if each of n the d-dimensional basic sets i in "set",
+ * after transformation, contains the origin,
+ * satisfies the constraints x_1 >= 0 and x_2 >= 0
  * and is defined by the constraints
  *				    [ 1 ]
  *				A_i [ x ]  >= 0
@@ -291,19 +340,28 @@ error:
  *				      a_i   >= 0
  *
  *			\sum_i x_{i,1} = 1
+ *
+ * The transformation is applied directly to the constraint matrices
+ * of the basic sets rather than through isl_set_preimage since
+ * the transformed basic sets themselves are not needed and
+ * there is therefore no point in simplifying them.
+ * This function is called for each ridge of each facet of the convex hull,
+ * so this saves a significant amount of work.
  */
-static struct isl_basic_set *wrap_constraints(struct isl_set *set)
+static __isl_give isl_basic_set *wrap_constraints(__isl_keep isl_set *set,
+	__isl_keep isl_mat *T)
 {
 	struct isl_basic_set *lp;
 	unsigned n_eq;
 	unsigned n_ineq;
-	int i, j, k;
+	int i, k;
 	unsigned dim, lp_dim;
 
-	if (!set)
+	if (!set || !T)
 		return NULL;
 
 	dim = 1 + isl_set_n_dim(set);
+	isl_assert(set->ctx, T->n_row == dim && T->n_col == dim, return NULL);
 	n_eq = 1;
 	n_ineq = set->n;
 	for (i = 0; i < set->n; ++i) {
@@ -324,22 +382,17 @@ static struct isl_basic_set *wrap_constraints(struct isl_set *set)
 	}
 	for (i = 0; i < set->n; ++i) {
 		k = isl_basic_set_alloc_inequality(lp);
+		if (k < 0)
+			return isl_basic_set_free(lp);
 		isl_seq_clr(lp->ineq[k], 1+lp_dim);
 		isl_int_set_si(lp->ineq[k][1+dim*i], 1);
 
-		for (j = 0; j < set->p[i]->n_eq; ++j) {
-			k = isl_basic_set_alloc_equality(lp);
-			isl_seq_clr(lp->eq[k], 1+dim*i);
-			isl_seq_cpy(lp->eq[k]+1+dim*i, set->p[i]->eq[j], dim);
-			isl_seq_clr(lp->eq[k]+1+dim*(i+1), dim*(set->n-i-1));
-		}
-
-		for (j = 0; j < set->p[i]->n_ineq; ++j) {
-			k = isl_basic_set_alloc_inequality(lp);
-			isl_seq_clr(lp->ineq[k], 1+dim*i);
-			isl_seq_cpy(lp->ineq[k]+1+dim*i, set->p[i]->ineq[j], dim);
-			isl_seq_clr(lp->ineq[k]+1+dim*(i+1), dim*(set->n-i-1));
-		}
+		lp = add_wrap_constraints(lp, set, i, set->p[i]->eq,
+					set->p[i]->n_eq, 1, T);
+		lp = add_wrap_constraints(lp, set, i, set->p[i]->ineq,
+					set->p[i]->n_ineq, 0, T);
+		if (!lp)
+			return NULL;
 	}
 	return lp;
 }
@@ -416,8 +469,6 @@ isl_int *isl_set_wrap_facet(__isl_keep isl_set *set,
 	if (!set)
 		return NULL;
 	ctx = set->ctx;
-	set = isl_set_copy(set);
-	set = isl_set_set_rational(set);
 
 	dim = 1 + isl_set_n_dim(set);
 	T = isl_mat_alloc(ctx, 3, dim);
@@ -428,11 +479,11 @@ isl_int *isl_set_wrap_facet(__isl_keep isl_set *set,
 	isl_seq_cpy(T->row[1], facet, dim);
 	isl_seq_cpy(T->row[2], ridge, dim);
 	T = isl_mat_right_inverse(T);
-	set = isl_set_preimage(set, T);
+	lp = wrap_constraints(set, T);
+	isl_mat_free(T);
 	T = NULL;
-	if (!set)
+	if (!lp)
 		goto error;
-	lp = wrap_constraints(set);
 	obj = isl_vec_alloc(ctx, 1 + dim*set->n);
 	if (!obj)
 		goto error;
@@ -455,7 +506,6 @@ isl_int *isl_set_wrap_facet(__isl_keep isl_set *set,
 	isl_int_clear(den);
 	isl_vec_free(obj);
 	isl_basic_set_free(lp);
-	isl_set_free(set);
 	if (res == isl_lp_error)
 		return NULL;
 	isl_assert(ctx, res == isl_lp_ok || res == isl_lp_unbounded, 
@@ -464,7 +514,6 @@ isl_int *isl_set_wrap_facet(__isl_keep isl_set *set,
 error:
 	isl_basic_set_free(lp);
 	isl_mat_free(T);
-	isl_set_free(set);
 	return NULL;
 }
 
@@ -1998,6 +2047,10 @@ __isl_give isl_basic_set *isl_set_polyhedral_hull(__isl_take isl_set *set)
 struct sh_data_entry {
 	struct isl_hash_table	*table;
 	struct isl_tab		*tab;
+	isl_vec			*lower;
+	isl_vec			*upper;
+	int			*has_lower;
+	int			*has_upper;
 };
 
 /* Holds the data needed during the simple hull computation.
@@ -2008,6 +2061,14 @@ struct sh_data_entry {
  *	p		for each basic set,
  *		table		a hash table of the constraints
  *		tab		the tableau corresponding to the basic set
+ *		lower		lower bounds on the variables, where known
+ *		upper		upper bounds on the variables, where known
+ *		has_lower	for each variable, whether lower is known
+ *		has_upper	for each variable, whether upper is known
+ *
+ * The bounds form a box containing the basic set and
+ * are only computed (from the constraints of the basic set)
+ * when they are first needed.
  */
 struct sh_data {
 	struct isl_ctx		*ctx;
@@ -2026,6 +2087,10 @@ static void sh_data_free(struct sh_data *data)
 	for (i = 0; i < data->n; ++i) {
 		isl_hash_table_free(data->ctx, data->p[i].table);
 		isl_tab_free(data->p[i].tab);
+		isl_vec_free(data->p[i].lower);
+		isl_vec_free(data->p[i].upper);
+		free(data->p[i].has_lower);
+		free(data->p[i].has_upper);
 	}
 	free(data);
 }
@@ -2114,12 +2179,128 @@ error:
 	return NULL;
 }
 
+/* Update the box "entry" with the bound on a single variable
+ * imposed by the constraint "c", where "total" is the number of variables.
+ * If "eq" is set, then "c" is an equality and it imposes both
+ * a lower and an upper bound.
+ * Only constraints that involve a single variable with
+ * a unit coefficient are taken into account such that
+ * the resulting bounds are exact bounds on the rational relaxation.
+ * If there are several such bounds, then the tightest one is kept.
+ */
+static void update_box(struct sh_data_entry *entry, isl_int *c,
+	unsigned total, int eq)
+{
+	int pos;
+	isl_int v;
+
+	pos = isl_seq_first_non_zero(c + 1, total);
+	if (pos < 0)
+		return;
+	if (isl_seq_first_non_zero(c + 1 + pos + 1, total - pos - 1) != -1)
+		return;
+	if (!isl_int_is_one(c[1 + pos]) && !isl_int_is_negone(c[1 + pos]))
+		return;
+
+	isl_int_init(v);
+	if (isl_int_is_one(c[1 + pos]))
+		isl_int_neg(v, c[0]);
+	else
+		isl_int_set(v, c[0]);
+	if ((eq || isl_int_is_one(c[1 + pos])) &&
+	    (!entry->has_lower[pos] || isl_int_gt(v, entry->lower->el[pos]))) {
+		isl_int_set(entry->lower->el[pos], v);
+		entry->has_lower[pos] = 1;
+	}
+	if ((eq || isl_int_is_negone(c[1 + pos])) &&
+	    (!entry->has_upper[pos] || isl_int_lt(v, entry->upper->el[pos]))) {
+		isl_int_set(entry->upper->el[pos], v);
+		entry->has_upper[pos] = 1;
+	}
+	isl_int_clear(v);
+}
+
+/* Compute a box containing basic set "j" of "set" from
+ * those constraints of the basic set that bound a single variable.
+ */
+static isl_stat compute_box(struct sh_data *data, __isl_keep isl_set *set,
+	int j)
+{
+	int i;
+	unsigned total;
+	isl_basic_set *bset = set->p[j];
+	struct sh_data_entry *entry = &data->p[j];
+
+	total = isl_basic_set_total_dim(bset);
+	entry->lower = isl_vec_alloc(data->ctx, total);
+	entry->upper = isl_vec_alloc(data->ctx, total);
+	entry->has_lower = isl_calloc_array(data->ctx, int, total);
+	entry->has_upper = isl_calloc_array(data->ctx, int, total);
+	if (!entry->lower || !entry->upper ||
+	    (total && (!entry->has_lower || !entry->has_upper)))
+		return isl_stat_error;
+
+	for (i = 0; i < bset->n_eq; ++i)
+		update_box(entry, bset->eq[i], total, 1);
+	for (i = 0; i < bset->n_ineq; ++i)
+		update_box(entry, bset->ineq[i], total, 0);
+
+	return isl_stat_ok;
+}
+
+/* Is inequality "ineq" known to be satisfied by all elements
+ * of the box containing basic set "j" of "set"?
+ * That is, is the minimum of "ineq" over the box non-negative?
+ * If the minimum cannot be computed because the box is unbounded
+ * in a direction in which "ineq" decreases, then return isl_bool_false.
+ */
+static isl_bool box_is_bound(struct sh_data *data, __isl_keep isl_set *set,
+	int j, isl_int *ineq)
+{
+	int k;
+	unsigned total;
+	isl_bool bound = isl_bool_true;
+	struct sh_data_entry *entry = &data->p[j];
+	isl_int min;
+
+	if (!entry->lower && compute_box(data, set, j) < 0)
+		return isl_bool_error;
+
+	total = isl_basic_set_total_dim(set->p[j]);
+	isl_int_init(min);
+	isl_int_set(min, ineq[0]);
+	for (k = 0; k < total; ++k) {
+		if (isl_int_is_zero(ineq[1 + k]))
+			continue;
+		if (isl_int_is_pos(ineq[1 + k]) && !entry->has_lower[k])
+			break;
+		if (isl_int_is_neg(ineq[1 + k]) && !entry->has_upper[k])
+			break;
+		if (isl_int_is_pos(ineq[1 + k]))
+			isl_int_addmul(min, ineq[1 + k], entry->lower->el[k]);
+		else
+			isl_int_addmul(min, ineq[1 + k], entry->upper->el[k]);
+	}
+	if (k < total || isl_int_is_neg(min))
+		bound = isl_bool_false;
+	isl_int_clear(min);
+
+	return bound;
+}
+
 /* Check if inequality "ineq" is a bound for basic set "j" or if
  * it can be relaxed (by increasing the constant term) to become
  * a bound for that basic set.  In the latter case, the constant
  * term is updated.
  * Relaxation of the constant term is only allowed if "shift" is set.
  *
+ * Before solving an LP, check if "ineq" is already satisfied
+ * by all elements of a box containing the basic set.
+ * If so, it is a bound and there is no need to relax it.
+ * Note that the tableau of the basic set is reused
+ * for all inequalities that need to be checked, so that
+ * each LP starts from the optimal basis of the previous one.
+ *
  * Return 1 if "ineq" is a bound
  *	  0 if "ineq" may attain arbitrarily small values on basic set "j"
  *	 -1 if some error occurred
@@ -2128,8 +2309,18 @@ static int is_bound(struct sh_data *data, struct isl_set *set, int j,
 	isl_int *ineq, int shift)
 {
 	enum isl_lp_result res;
+	isl_bool box_bound;
 	isl_int opt;
 
+	box_bound = box_is_bound(data, set, j, ineq);
+	if (box_bound < 0)
+		return -1;
+	if (box_bound) {
+		data->ctx->stats->simple_hull_box_bounds++;
+		return 1;
+	}
+
+	data->ctx->stats->simple_hull_lps++;
 	if (!data->p[j].tab) {
 		data->p[j].tab = isl_tab_from_basic_set(set->p[j], 0);
 		if (!data->p[j].tab)
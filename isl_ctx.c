@@ -7,9 +7,14 @@
  * Computerwetenschappen, Celestijnenlaan 200A, B-3001 Leuven, Belgium
  */
 
+#include <time.h>
+#include <isl_config.h>
 #include <isl_ctx_private.h>
 #include <isl/vec.h>
 #include <isl_options_private.h>
+#include <isl_closure_cache.h>
+#include <isl_thread_pool.h>
+#include <isl_refcount.h>
 
 #define __isl_calloc(type,size)		((type *)calloc(1, size))
 #define __isl_calloc_type(type)		__isl_calloc(type,sizeof(type))
@@ -33,18 +38,113 @@ static void *check_non_null(isl_ctx *ctx, void *p, size_t size)
 	isl_die(ctx, isl_error_alloc, "allocation failure", return NULL);
 }
 
+/* The number of operations between two consecutive checks
+ * of the deadline in isl_ctx_next_operation.
+ */
+#define ISL_DEADLINE_CHECK_INTERVAL	256
+
+/* Return the current time in microseconds, measured using
+ * a monotonic clock if one is available.
+ */
+#ifdef HAVE_CLOCK_GETTIME
+uint64_t isl_clock_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#else
+uint64_t isl_clock_us(void)
+{
+	return (uint64_t) time(NULL) * 1000000;
+}
+#endif
+
+/* Return the current time in milliseconds.
+ */
+static uint64_t clock_ms(void)
+{
+	return isl_clock_us() / 1000;
+}
+
+/* Return the deadline that lies "timeout" milliseconds from now,
+ * or 0 (meaning no deadline) if "timeout" is zero.
+ */
+uint64_t isl_deadline_from_timeout(unsigned long timeout)
+{
+	return timeout ? clock_ms() + timeout : 0;
+}
+
+/* Is "deadline" an actual deadline (i.e., not zero) and has it passed?
+ */
+int isl_deadline_passed(uint64_t deadline)
+{
+	return deadline && clock_ms() >= deadline;
+}
+
+/* Has a deadline been set on "ctx" and has it passed?
+ */
+static int deadline_passed(isl_ctx *ctx)
+{
+	return isl_deadline_passed(ctx->deadline);
+}
+
+/* Has the computation in "ctx" been aborted explicitly?
+ * If "ctx" is the context of a worker of a thread pool,
+ * then an abort of the context that owns the pool
+ * also aborts the computation in "ctx".
+ */
+static int aborted(isl_ctx *ctx)
+{
+	return ctx->abort || (ctx->parent_abort && *ctx->parent_abort);
+}
+
+/* Return -1 and mark "ctx" as having been aborted
+ * if the user has explicitly aborted the computation or
+ * if the deadline has passed.
+ * Otherwise, return 0.
+ *
+ * This is meant to be called at the start of each iteration
+ * of the outer loops of potentially expensive computations
+ * that do not necessarily perform any low-level operation
+ * in every iteration.
+ */
+int isl_ctx_check_interrupt(isl_ctx *ctx)
+{
+	if (!ctx)
+		return -1;
+	if (aborted(ctx) || deadline_passed(ctx)) {
+		isl_ctx_set_error(ctx, isl_error_abort);
+		return -1;
+	}
+	return 0;
+}
+
 /* Prepare for performing the next "operation" in the context.
  * Return 0 if we are allowed to perform this operation and
  * return -1 if we should abort the computation.
  *
  * In particular, we should stop if the user has explicitly aborted
- * the computation or if the maximal number of operations has been exceeded.
+ * the computation, if the deadline has passed or
+ * if the maximal number of operations has been exceeded.
+ * Since reading the clock is more expensive than most operations,
+ * the deadline is only checked every ISL_DEADLINE_CHECK_INTERVAL
+ * operations.  The operation counter is not incremented
+ * if the deadline has passed, so that any further operation
+ * performs the check again.
  */
 int isl_ctx_next_operation(isl_ctx *ctx)
 {
 	if (!ctx)
 		return -1;
-	if (ctx->abort) {
+	if (aborted(ctx)) {
+		isl_ctx_set_error(ctx, isl_error_abort);
+		return -1;
+	}
+	if (ctx->deadline &&
+	    ctx->operations % ISL_DEADLINE_CHECK_INTERVAL == 0 &&
+	    deadline_passed(ctx)) {
 		isl_ctx_set_error(ctx, isl_error_abort);
 		return -1;
 	}
@@ -206,6 +306,8 @@ isl_ctx *isl_ctx_alloc_with_options(struct isl_args *args, void *user_opt)
 
 	ctx->operations = 0;
 	isl_ctx_set_max_operations(ctx, ctx->opt->max_operations);
+	ctx->deadline = 0;
+	ctx->parent_abort = NULL;
 
 	return ctx;
 error:
@@ -227,13 +329,13 @@ struct isl_ctx *isl_ctx_alloc()
 
 void isl_ctx_ref(struct isl_ctx *ctx)
 {
-	ctx->ref++;
+	isl_refcount_inc(ctx->ref);
 }
 
 void isl_ctx_deref(struct isl_ctx *ctx)
 {
-	isl_assert(ctx, ctx->ref > 0, return);
-	ctx->ref--;
+	isl_assert(ctx, isl_refcount_get(ctx->ref) > 0, return);
+	isl_refcount_dec(ctx->ref);
 }
 
 /* Print statistics on usage.
@@ -241,12 +343,27 @@ void isl_ctx_deref(struct isl_ctx *ctx)
 static void print_stats(isl_ctx *ctx)
 {
 	fprintf(stderr, "operations: %lu\n", ctx->operations);
+	fprintf(stderr, "simplify calls: %ld\n", ctx->stats->simplify_calls);
+	fprintf(stderr, "simplify skipped: %ld\n",
+		ctx->stats->simplify_skipped);
+	fprintf(stderr, "simple hull LPs: %ld\n", ctx->stats->simple_hull_lps);
+	fprintf(stderr, "simple hull box bounds: %ld\n",
+		ctx->stats->simple_hull_box_bounds);
+	fprintf(stderr, "closure cache hits: %ld\n",
+		ctx->stats->closure_cache_hits);
+	fprintf(stderr, "closure cache misses: %ld\n",
+		ctx->stats->closure_cache_misses);
+	fprintf(stderr, "tableau pivots: %ld\n", ctx->stats->tab_pivots);
 }
 
 void isl_ctx_free(struct isl_ctx *ctx)
 {
 	if (!ctx)
 		return;
+	isl_thread_pool_free(ctx->thread_pool);
+	ctx->thread_pool = NULL;
+	isl_closure_cache_free(ctx->closure_cache);
+	ctx->closure_cache = NULL;
 	if (ctx->ref != 0)
 		isl_die(ctx, isl_error_invalid,
 			"isl_ctx freed, but some objects still reference it",
@@ -265,6 +382,7 @@ void isl_ctx_free(struct isl_ctx *ctx)
 	isl_args_free(ctx->user_args, ctx->user_opt);
 	if (ctx->opt_allocated)
 		isl_options_free(ctx->opt);
+	free(ctx->sched_stats);
 	free(ctx->stats);
 	free(ctx);
 }
@@ -292,6 +410,12 @@ void isl_ctx_set_error(isl_ctx *ctx, enum isl_error error)
 		ctx->error = error;
 }
 
+/* Abort any computation that is currently running in "ctx"
+ * and any computation that is started later,
+ * until isl_ctx_resume is called.
+ * Since this only sets a flag of type sig_atomic_t,
+ * it may be called from a signal handler.
+ */
 void isl_ctx_abort(isl_ctx *ctx)
 {
 	if (ctx)
@@ -304,9 +428,13 @@ void isl_ctx_resume(isl_ctx *ctx)
 		ctx->abort = 0;
 }
 
+/* Has the computation in "ctx" been aborted explicitly,
+ * either directly or, for the context of a worker of a thread pool,
+ * through the context that owns the pool?
+ */
 int isl_ctx_aborted(isl_ctx *ctx)
 {
-	return ctx ? ctx->abort : -1;
+	return ctx ? aborted(ctx) : -1;
 }
 
 int isl_ctx_parse_options(isl_ctx *ctx, int argc, char **argv, unsigned flags)
@@ -340,3 +468,14 @@ void isl_ctx_reset_operations(isl_ctx *ctx)
 		return;
 	ctx->operations = 0;
 }
+
+/* Abort any computation in "ctx" that is still running
+ * "timeout" milliseconds from now.
+ * A timeout of zero removes any previously set deadline.
+ */
+void isl_ctx_set_deadline(isl_ctx *ctx, unsigned long timeout)
+{
+	if (!ctx)
+		return;
+	ctx->deadline = isl_deadline_from_timeout(timeout);
+}
@@ -1,10 +1,15 @@
+#include <signal.h>
 #include <isl/ctx.h>
+#include <isl/stdint.h>
 #include <isl_blk.h>
 
+struct isl_sched_stats;
+
 struct isl_ctx {
 	int			ref;
 
 	struct isl_stats	*stats;
+	struct isl_sched_stats	*sched_stats;
 
 	int			 opt_allocated;
 	struct isl_options	*opt;
@@ -23,12 +28,22 @@ struct isl_ctx {
 	struct isl_blk		cache[ISL_BLK_CACHE_SIZE];
 	struct isl_hash_table	id_table;
 
+	struct isl_closure_cache	*closure_cache;
+	struct isl_thread_pool		*thread_pool;
+
 	enum isl_error		error;
 
-	int			abort;
+	volatile sig_atomic_t	abort;
+	volatile sig_atomic_t	*parent_abort;
 
 	unsigned long		operations;
 	unsigned long		max_operations;
+	uint64_t		deadline;
 };
 
 int isl_ctx_next_operation(isl_ctx *ctx);
+int isl_ctx_check_interrupt(isl_ctx *ctx);
+
+uint64_t isl_clock_us(void);
+uint64_t isl_deadline_from_timeout(unsigned long timeout);
+int isl_deadline_passed(uint64_t deadline);
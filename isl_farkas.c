@@ -8,10 +8,15 @@
  * 91893 Orsay, France 
  */
 
+#include <isl_ctx_private.h>
 #include <isl_map_private.h>
 #include <isl/set.h>
 #include <isl_space_private.h>
 #include <isl_seq.h>
+#include <isl_mat_private.h>
+#include <isl_vec_private.h>
+#include <isl_aff_private.h>
+#include <isl/vertices.h>
 
 /*
  * Let C be a cone and define
@@ -316,6 +321,314 @@ error:
 	return NULL;
 }
 
+/* Return the number of subsets of size "k" of a set of size "n",
+ * or "max" + 1 if this number is greater than "max".
+ */
+static int n_subsets_bounded(int n, int k, int max)
+{
+	int i;
+	long r = 1;
+
+	if (k < 0 || k > n)
+		return 0;
+	if (k > n - k)
+		k = n - k;
+	for (i = 1; i <= k; ++i) {
+		r = r * (n - k + i) / i;
+		if (r > max)
+			return max + 1;
+	}
+
+	return r;
+}
+
+/* Construct the homogeneous cone
+ *
+ *	C = { [z,x] | b z + A x >= 0 and z >= 0 }
+ *
+ * representing "bset", where the parameters of "bset"
+ * are treated as variables.
+ * The constraints of "bset" are simply shifted one position to the right
+ * such that the constant term becomes the coefficient of z.
+ *
+ * If "lin" is not NULL, then it is a matrix whose columns form
+ * a basis for the lineality space L of C and the result
+ * is the intersection of C with the orthogonal complement of L and
+ * with the half-space f [z,x] <= 1, where f is the sum of
+ * the inequality constraints of C.
+ */
+static __isl_give isl_basic_set *homogeneous_cone(
+	__isl_keep isl_basic_set *bset, __isl_keep isl_mat *lin)
+{
+	int i, j, k;
+	int n_lin;
+	unsigned total;
+	isl_ctx *ctx;
+	isl_basic_set *cone;
+
+	ctx = isl_basic_set_get_ctx(bset);
+	total = isl_basic_set_total_dim(bset);
+	n_lin = lin ? lin->n_col : 0;
+	cone = isl_basic_set_alloc(ctx, 0, 1 + total, 0,
+			bset->n_eq + n_lin, bset->n_ineq + 1 + (lin != NULL));
+	cone = isl_basic_set_set_rational(cone);
+	for (i = 0; i < bset->n_eq; ++i) {
+		k = isl_basic_set_alloc_equality(cone);
+		if (k < 0)
+			goto error;
+		isl_int_set_si(cone->eq[k][0], 0);
+		isl_seq_cpy(cone->eq[k] + 1, bset->eq[i], 1 + total);
+	}
+	for (i = 0; i < bset->n_ineq; ++i) {
+		k = isl_basic_set_alloc_inequality(cone);
+		if (k < 0)
+			goto error;
+		isl_int_set_si(cone->ineq[k][0], 0);
+		isl_seq_cpy(cone->ineq[k] + 1, bset->ineq[i], 1 + total);
+	}
+	k = isl_basic_set_alloc_inequality(cone);
+	if (k < 0)
+		goto error;
+	isl_seq_clr(cone->ineq[k], 2 + total);
+	isl_int_set_si(cone->ineq[k][1], 1);
+
+	if (!lin)
+		return cone;
+
+	for (i = 0; i < n_lin; ++i) {
+		k = isl_basic_set_alloc_equality(cone);
+		if (k < 0)
+			goto error;
+		isl_int_set_si(cone->eq[k][0], 0);
+		for (j = 0; j < 1 + total; ++j)
+			isl_int_set(cone->eq[k][1 + j], lin->row[j][i]);
+	}
+
+	k = isl_basic_set_alloc_inequality(cone);
+	if (k < 0)
+		goto error;
+	isl_seq_clr(cone->ineq[k], 2 + total);
+	for (i = 0; i < k; ++i)
+		isl_seq_combine(cone->ineq[k] + 1, cone->ctx->one,
+			cone->ineq[k] + 1, cone->ctx->negone,
+			cone->ineq[i] + 1, 1 + total);
+	isl_int_set_si(cone->ineq[k][0], 1);
+
+	return cone;
+error:
+	isl_basic_set_free(cone);
+	return NULL;
+}
+
+/* Return a matrix whose columns form a basis for the lineality space
+ * of the homogeneous cone representing "bset", i.e.,
+ * the space of elements that satisfy all constraints of the cone
+ * with equality.
+ */
+static __isl_give isl_mat *homogeneous_cone_lineality(
+	__isl_keep isl_basic_set *bset)
+{
+	int i;
+	unsigned total;
+	isl_ctx *ctx;
+	isl_basic_set *cone;
+	isl_mat *mat;
+
+	cone = homogeneous_cone(bset, NULL);
+	if (!cone)
+		return NULL;
+
+	ctx = isl_basic_set_get_ctx(cone);
+	total = isl_basic_set_total_dim(cone);
+	mat = isl_mat_alloc(ctx, cone->n_eq + cone->n_ineq, total);
+	for (i = 0; mat && i < cone->n_eq; ++i)
+		isl_seq_cpy(mat->row[i], cone->eq[i] + 1, total);
+	for (i = 0; mat && i < cone->n_ineq; ++i)
+		isl_seq_cpy(mat->row[cone->n_eq + i], cone->ineq[i] + 1, total);
+	isl_basic_set_free(cone);
+
+	return isl_mat_right_kernel(mat);
+}
+
+/* Return an upper bound on the number of extreme rays of the cone
+ *
+ *	C = { [z,x] | b z + A x >= 0 and z >= 0 }
+ *
+ * representing "bset" in homogeneous coordinates, after
+ * removing its lineality space, or "max" + 1
+ * if this bound is greater than "max" or if the dual of "bset"
+ * cannot be constructed from these extreme rays
+ * by isl_basic_set_coefficients_from_generators.
+ * Return -1 on error.
+ *
+ * Each extreme ray is determined by d - 1 of the inequality constraints
+ * of C, with d the dimension of the pointed part of C, i.e.,
+ * the number of variables of C minus the number of
+ * (independent) equality constraints and
+ * minus the dimension of the lineality space.
+ * The bound is therefore the number of ways of selecting d - 1 inequalities.
+ * This bound is cheap to compute, but it can be fairly pessimistic.
+ */
+int isl_basic_set_n_generators_bound(__isl_keep isl_basic_set *bset, int max)
+{
+	int dim;
+	isl_mat *lin;
+
+	if (!bset)
+		return -1;
+	if (bset->n_div || isl_basic_set_plain_is_empty(bset))
+		return max + 1;
+
+	lin = homogeneous_cone_lineality(bset);
+	if (!lin)
+		return -1;
+	dim = 1 + isl_basic_set_total_dim(bset) - bset->n_eq - lin->n_col;
+	isl_mat_free(lin);
+
+	return n_subsets_bounded(bset->n_ineq + 1, dim - 1, max);
+}
+
+/* Add a constraint to "user", the dual of the homogeneous cone C
+ * of some basic set, expressing that the element of C corresponding
+ * to "vertex" is a non-negative combination of the elements of the dual.
+ * "vertex" is a vertex of a polytope that is obtained by intersecting C
+ * with a half-space and therefore has a constant value in each coordinate.
+ * Since these values may be rational, the constraint is multiplied
+ * by the least common multiple of their denominators.
+ */
+static isl_stat add_generator(__isl_take isl_vertex *vertex, void *user)
+{
+	isl_basic_set **dual = user;
+	isl_multi_aff *ma;
+	int i, k, n;
+	isl_int lcm, f;
+
+	ma = isl_vertex_get_expr(vertex);
+	isl_vertex_free(vertex);
+	if (!ma)
+		return isl_stat_error;
+
+	n = isl_multi_aff_dim(ma, isl_dim_out);
+	k = isl_basic_set_alloc_inequality(*dual);
+	if (k < 0) {
+		isl_multi_aff_free(ma);
+		return isl_stat_error;
+	}
+
+	isl_int_init(lcm);
+	isl_int_init(f);
+	isl_int_set_si(lcm, 1);
+	for (i = 0; i < n; ++i)
+		isl_int_lcm(lcm, lcm, ma->p[i]->v->el[0]);
+	isl_int_set_si((*dual)->ineq[k][0], 0);
+	for (i = 0; i < n; ++i) {
+		isl_int_divexact(f, lcm, ma->p[i]->v->el[0]);
+		isl_int_mul((*dual)->ineq[k][1 + i], f, ma->p[i]->v->el[1]);
+	}
+	isl_int_clear(f);
+	isl_int_clear(lcm);
+
+	isl_multi_aff_free(ma);
+	return isl_stat_ok;
+}
+
+/* Construct a basic set containing the tuples of coefficients of all
+ * valid affine constraints on "bset", as in isl_basic_set_coefficients,
+ * but using the generators of the homogeneous cone
+ *
+ *	C = { [z,x] | b z + A x >= 0 and z >= 0 }
+ *
+ * representing "bset" rather than Farkas' lemma.
+ *
+ * Let L be the lineality space of C, with basis l_j, and
+ * let g_i be the extreme rays of the pointed cone P obtained by
+ * intersecting C with the orthogonal complement of L.
+ * Then C = L + P is the set of sums of elements of L and
+ * non-negative combinations of the g_i, such that
+ *
+ *	C' = { y | y l_j = 0 for all j and y g_i >= 0 for all i }
+ *
+ * The extreme rays are computed from the vertices of the polytope
+ * obtained by intersecting P with the half-space f [z,x] <= 1,
+ * where f is the sum of the inequality constraints of C.
+ * Since f [z,x] > 0 for any non-zero element of P,
+ * this polytope is bounded and its vertices other than the origin
+ * lie on the extreme rays of P.
+ * The origin results in a trivial constraint that gets removed
+ * by the simplification.
+ * The half-space is used instead of the hyperplane f [z,x] = 1
+ * because isl_basic_set_compute_vertices compresses away equality
+ * constraints assuming they have integer solutions.
+ *
+ * Unlike Farkas' lemma, this construction does not require
+ * the elimination of any multipliers, but the number of generators
+ * may be exponential in the number of constraints of "bset".
+ * The caller can use isl_basic_set_n_generators_bound to decide
+ * which construction to use.
+ *
+ * If "bset" is (obviously) empty, then C does not represent "bset" and
+ * Farkas' lemma is used instead.
+ */
+__isl_give isl_basic_set *isl_basic_set_coefficients_from_generators(
+	__isl_take isl_basic_set *bset)
+{
+	int i, j, k;
+	unsigned total;
+	isl_space *space;
+	isl_basic_set *cone, *dual;
+	isl_vertices *vertices;
+	isl_mat *lin;
+	int n;
+
+	if (!bset)
+		return NULL;
+	if (bset->n_div)
+		isl_die(bset->ctx, isl_error_invalid,
+			"input set not allowed to have local variables",
+			goto error);
+	if (isl_basic_set_plain_is_empty(bset))
+		return isl_basic_set_coefficients(bset);
+
+	lin = homogeneous_cone_lineality(bset);
+	if (!lin)
+		goto error;
+	cone = homogeneous_cone(bset, lin);
+	vertices = isl_basic_set_compute_vertices(cone);
+	isl_basic_set_free(cone);
+	if (!vertices)
+		goto error_lin;
+
+	total = isl_basic_set_total_dim(bset);
+	n = isl_vertices_get_n_vertices(vertices);
+	space = isl_space_coefficients(isl_basic_set_get_space(bset));
+	dual = isl_basic_set_alloc_space(space, 0, lin->n_col, n);
+	dual = isl_basic_set_set_rational(dual);
+	for (i = 0; i < lin->n_col; ++i) {
+		k = isl_basic_set_alloc_equality(dual);
+		if (k < 0)
+			break;
+		isl_int_set_si(dual->eq[k][0], 0);
+		for (j = 0; j < 1 + total; ++j)
+			isl_int_set(dual->eq[k][1 + j], lin->row[j][i]);
+	}
+	if (i < lin->n_col ||
+	    isl_vertices_foreach_vertex(vertices, &add_generator, &dual) < 0)
+		dual = isl_basic_set_free(dual);
+	isl_vertices_free(vertices);
+	isl_mat_free(lin);
+
+	dual = isl_basic_set_simplify(dual);
+	dual = isl_basic_set_finalize(dual);
+
+	isl_basic_set_free(bset);
+	return dual;
+error_lin:
+	isl_mat_free(lin);
+error:
+	isl_basic_set_free(bset);
+	return NULL;
+}
+
 /* Construct a basic set containing the elements that satisfy all
  * affine constraints whose coefficient tuples are
  * contained in the given basic set.
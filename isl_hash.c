@@ -61,30 +61,41 @@ int isl_hash_table_init(struct isl_ctx *ctx, struct isl_hash_table *table,
 	return 0;
 }
 
-/* Dummy comparison function that always returns false.
+/* Return the position of the first free slot in "table"
+ * in the probe sequence of "key_hash".
+ * The table is assumed to have at least one free slot.
  */
-static int no(const void *entry, const void *val)
+static uint32_t free_slot(struct isl_hash_table *table, uint32_t key_hash)
 {
-	return 0;
+	uint32_t h, mask;
+
+	mask = (1 << table->bits) - 1;
+	for (h = isl_hash_bits(key_hash, table->bits);
+	     table->entries[h].data; h = (h + 1) & mask)
+		;
+
+	return h;
 }
 
-/* Extend "table" to twice its size.
+/* Extend "table" to a size of 2^"bits", with "bits" greater than
+ * the current number of bits.
  * Return 0 on success and -1 on error.
  *
- * We reuse isl_hash_table_find to create entries in the extended table.
  * Since all entries in the original table are assumed to be different,
- * there is no need to compare them against each other.
+ * there is no need to compare them against each other and
+ * each entry can simply be moved to the first free slot
+ * in its probe sequence in the extended table.
  */
-static int grow_table(struct isl_ctx *ctx, struct isl_hash_table *table)
+static int resize_table(struct isl_ctx *ctx, struct isl_hash_table *table,
+	int bits)
 {
-	int n;
 	size_t old_size, size;
 	struct isl_hash_table_entry *entries;
 	uint32_t h;
 
 	entries = table->entries;
 	old_size = 1 << table->bits;
-	size = 2 * old_size;
+	size = 1 << bits;
 	table->entries = isl_calloc_array(ctx, struct isl_hash_table_entry,
 					  size);
 	if (!table->entries) {
@@ -92,27 +103,12 @@ static int grow_table(struct isl_ctx *ctx, struct isl_hash_table *table)
 		return -1;
 	}
 
-	n = table->n;
-	table->n = 0;
-	table->bits++;
+	table->bits = bits;
 
 	for (h = 0; h < old_size; ++h) {
-		struct isl_hash_table_entry *entry;
-
 		if (!entries[h].data)
 			continue;
-
-		entry = isl_hash_table_find(ctx, table, entries[h].hash,
-					    &no, NULL, 1);
-		if (!entry) {
-			table->bits--;
-			free(table->entries);
-			table->entries = entries;
-			table->n = n;
-			return -1;
-		}
-
-		*entry = entries[h];
+		table->entries[free_slot(table, entries[h].hash)] = entries[h];
 	}
 
 	free(entries);
@@ -120,6 +116,33 @@ static int grow_table(struct isl_ctx *ctx, struct isl_hash_table *table)
 	return 0;
 }
 
+/* Extend "table" to twice its size.
+ * Return 0 on success and -1 on error.
+ */
+static int grow_table(struct isl_ctx *ctx, struct isl_hash_table *table)
+{
+	return resize_table(ctx, table, table->bits + 1);
+}
+
+/* Make sure "table" can hold "n" more entries without having
+ * to be extended, extending it (only once) if needed.
+ * Return 0 on success and -1 on error.
+ */
+int isl_hash_table_reserve(struct isl_ctx *ctx, struct isl_hash_table *table,
+	int n)
+{
+	int bits;
+
+	if (!table)
+		return -1;
+
+	for (bits = table->bits; 4 * (table->n + n) > 3 * (1 << bits); ++bits)
+		;
+	if (bits == table->bits)
+		return 0;
+	return resize_table(ctx, table, bits);
+}
+
 struct isl_hash_table *isl_hash_table_alloc(struct isl_ctx *ctx, int min_size)
 {
 	struct isl_hash_table *table = NULL;
@@ -162,11 +185,12 @@ struct isl_hash_table_entry *isl_hash_table_find(struct isl_ctx *ctx,
 				const void *val, int reserve)
 {
 	size_t size;
-	uint32_t h, key_bits;
+	uint32_t h, key_bits, mask;
 
 	key_bits = isl_hash_bits(key_hash, table->bits);
 	size = 1 << table->bits;
-	for (h = key_bits; table->entries[h].data; h = (h+1) % size)
+	mask = size - 1;
+	for (h = key_bits; table->entries[h].data; h = (h + 1) & mask)
 		if (table->entries[h].hash == key_hash &&
 		    eq(table->entries[h].data, val))
 			return &table->entries[h];
@@ -209,24 +233,25 @@ void isl_hash_table_remove(struct isl_ctx *ctx,
 				struct isl_hash_table_entry *entry)
 {
 	int h, h2;
-	size_t size;
+	size_t size, mask;
 
 	if (!table || !entry)
 		return;
 
 	size = 1 << table->bits;
+	mask = size - 1;
 	h = entry - table->entries;
 	isl_assert(ctx, h >= 0 && h < size, return);
 
-	for (h2 = h+1; table->entries[h2 % size].data; h2++) {
-		uint32_t bits = isl_hash_bits(table->entries[h2 % size].hash,
+	for (h2 = h+1; table->entries[h2 & mask].data; h2++) {
+		uint32_t bits = isl_hash_bits(table->entries[h2 & mask].hash,
 						table->bits);
-		uint32_t offset = (size + bits - (h+1)) % size;
+		uint32_t offset = (size + bits - (h+1)) & mask;
 		if (offset <= h2 - (h+1))
 			continue;
-		*entry = table->entries[h2 % size];
+		*entry = table->entries[h2 & mask];
 		h = h2;
-		entry = &table->entries[h % size];
+		entry = &table->entries[h & mask];
 	}
 
 	entry->hash = 0;
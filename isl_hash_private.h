@@ -5,4 +5,7 @@
 
 extern struct isl_hash_table_entry *isl_hash_table_entry_none;
 
+int isl_hash_table_reserve(struct isl_ctx *ctx, struct isl_hash_table *table,
+	int n);
+
 #endif
@@ -10,6 +10,8 @@
 #include <string.h>
 #include <isl_ctx_private.h>
 #include <isl_id_private.h>
+#include <isl_hash_private.h>
+#include <isl_refcount.h>
 
 #undef BASE
 #define BASE id
@@ -42,33 +44,51 @@ const char *isl_id_get_name(__isl_keep isl_id *id)
 	return id ? id->name : NULL;
 }
 
-static __isl_give isl_id *id_alloc(isl_ctx *ctx, const char *name, void *user)
+/* Return the hash value of an isl_id with the given name and user pointer.
+ */
+static uint32_t name_and_user_hash(const char *name, void *user)
+{
+	uint32_t hash = isl_hash_init();
+
+	if (name)
+		hash = isl_hash_string(hash, name);
+	else
+		hash = isl_hash_builtin(hash, user);
+
+	return hash;
+}
+
+/* Allocate a new isl_id with the given name, user pointer and
+ * hash value "hash", as computed by name_and_user_hash.
+ * The name is stored in the same block of memory as the isl_id itself,
+ * right after the structure, such that comparing the name
+ * of an isl_id found in the identifier table does not require
+ * a further memory access and such that an isl_id only
+ * requires a single allocation.
+ */
+static __isl_give isl_id *id_alloc(isl_ctx *ctx, const char *name, void *user,
+	uint32_t hash)
 {
-	const char *copy = name ? strdup(name) : NULL;
+	size_t len = name ? strlen(name) + 1 : 0;
 	isl_id *id;
 
-	if (name && !copy)
-		return NULL;
-	id = isl_calloc_type(ctx, struct isl_id);
+	id = isl_calloc(ctx, struct isl_id, sizeof(struct isl_id) + len);
 	if (!id)
-		goto error;
+		return NULL;
 
 	id->ctx = ctx;
 	isl_ctx_ref(id->ctx);
 	id->ref = 1;
-	id->name = copy;
-	id->user = user;
+	if (name) {
+		char *copy = (char *) (id + 1);
 
-	id->hash = isl_hash_init();
-	if (name)
-		id->hash = isl_hash_string(id->hash, name);
-	else
-		id->hash = isl_hash_builtin(id->hash, user);
+		memcpy(copy, name, len);
+		id->name = copy;
+	}
+	id->user = user;
+	id->hash = hash;
 
 	return id;
-error:
-	free((char *)copy);
-	return NULL;
 }
 
 uint32_t isl_id_get_hash(__isl_keep isl_id *id)
@@ -105,23 +125,45 @@ __isl_give isl_id *isl_id_alloc(isl_ctx *ctx, const char *name, void *user)
 	if (!ctx)
 		return NULL;
 
-	id_hash = isl_hash_init();
-	if (name)
-		id_hash = isl_hash_string(id_hash, name);
-	else
-		id_hash = isl_hash_builtin(id_hash, user);
+	id_hash = name_and_user_hash(name, user);
 	entry = isl_hash_table_find(ctx, &ctx->id_table, id_hash,
 					isl_id_has_name_and_user, &nu, 1);
 	if (!entry)
 		return NULL;
 	if (entry->data)
 		return isl_id_copy(entry->data);
-	entry->data = id_alloc(ctx, name, user);
+	entry->data = id_alloc(ctx, name, user, id_hash);
 	if (!entry->data)
 		ctx->id_table.n--;
 	return entry->data;
 }
 
+/* Construct a list of "n" isl_ids with the names in "names" and
+ * without user pointer.
+ * The identifier table is extended at most once, up front,
+ * rather than each time it fills up.
+ */
+__isl_give isl_id_list *isl_id_list_from_names(isl_ctx *ctx, int n,
+	const char **names)
+{
+	int i;
+	isl_id_list *list;
+
+	if (!ctx)
+		return NULL;
+	if (n < 0 || (n > 0 && !names))
+		isl_die(ctx, isl_error_invalid, "invalid list of names",
+			return NULL);
+	if (isl_hash_table_reserve(ctx, &ctx->id_table, n) < 0)
+		return NULL;
+
+	list = isl_id_list_alloc(ctx, n);
+	for (i = 0; i < n; ++i)
+		list = isl_id_list_add(list, isl_id_alloc(ctx, names[i], NULL));
+
+	return list;
+}
+
 /* If the id has a negative refcount, then it is a static isl_id
  * which should not be changed.
  */
@@ -130,10 +172,10 @@ __isl_give isl_id *isl_id_copy(isl_id *id)
 	if (!id)
 		return NULL;
 
-	if (id->ref < 0)
+	if (isl_refcount_get(id->ref) < 0)
 		return id;
 
-	id->ref++;
+	isl_refcount_inc(id->ref);
 	return id;
 }
 
@@ -207,6 +249,37 @@ __isl_give isl_id *isl_id_set_free_user(__isl_take isl_id *id,
 	return id;
 }
 
+/* Return an isl_id in "ctx" with the same name and user pointer as "id".
+ * The result is looked up in (or added to) the identifier table of "ctx"
+ * such that it is identical to any other isl_id with the same name
+ * and user pointer in "ctx".
+ * If "id" is not shared, then the responsibility of calling
+ * the free_user callback is handed over to the result,
+ * unless the result already has its own free_user callback.
+ * Otherwise, the callback stays with "id" and the caller needs
+ * to make sure the user pointer remains valid for as long as
+ * the result is being used.
+ * Static isl_ids are not tied to any isl_ctx and are returned unchanged.
+ */
+__isl_give isl_id *isl_id_transfer(__isl_take isl_id *id, isl_ctx *ctx)
+{
+	isl_id *res;
+
+	if (!id || !ctx)
+		return isl_id_free(id);
+	if (isl_refcount_get(id->ref) < 0 || id->ctx == ctx)
+		return id;
+
+	res = isl_id_alloc(ctx, id->name, id->user);
+	if (res && id->free_user && isl_refcount_get(id->ref) == 1 &&
+	    !res->free_user) {
+		res->free_user = id->free_user;
+		id->free_user = NULL;
+	}
+	isl_id_free(id);
+	return res;
+}
+
 /* If the id has a negative refcount, then it is a static isl_id
  * and should not be freed.
  */
@@ -217,10 +290,10 @@ __isl_null isl_id *isl_id_free(__isl_take isl_id *id)
 	if (!id)
 		return NULL;
 
-	if (id->ref < 0)
+	if (isl_refcount_get(id->ref) < 0)
 		return NULL;
 
-	if (--id->ref > 0)
+	if (isl_refcount_dec(id->ref) > 0)
 		return NULL;
 
 	entry = isl_hash_table_find(id->ctx, &id->ctx->id_table, id->hash,
@@ -234,7 +307,6 @@ __isl_null isl_id *isl_id_free(__isl_take isl_id *id)
 	if (id->free_user)
 		id->free_user(id->user);
 
-	free((char *)id->name);
 	isl_ctx_deref(id->ctx);
 	free(id);
 
@@ -40,6 +40,7 @@
 #include <isl_options_private.h>
 #include <isl_morph.h>
 #include <isl_val_private.h>
+#include <isl_refcount.h>
 #include <isl/deprecated/map_int.h>
 #include <isl/deprecated/set_int.h>
 
@@ -1068,6 +1069,61 @@ struct isl_basic_map *isl_basic_map_dup(struct isl_basic_map *bmap)
 	return dup;
 }
 
+/* Return a copy of "bmap" that lives in "ctx", which is assumed
+ * to be different from the context of "bmap".
+ * The constraints are copied directly into storage allocated in "ctx" and
+ * the identifiers in the space are remapped through isl_space_transfer.
+ * "bmap" itself is only read, such that this function can be called
+ * from a thread that does not own the context of "bmap".
+ * In particular, unlike isl_basic_map_copy, it does not allocate
+ * anything in the context of "bmap", even if "bmap" is not final.
+ */
+static __isl_give isl_basic_map *basic_map_dup_to_ctx(
+	__isl_keep isl_basic_map *bmap, isl_ctx *ctx)
+{
+	isl_space *space;
+	isl_basic_map *res;
+
+	space = isl_space_transfer(isl_space_copy(bmap->dim), ctx);
+	res = isl_basic_map_alloc_space(space,
+			bmap->n_div, bmap->n_eq, bmap->n_ineq);
+	if (!res)
+		return NULL;
+	dup_constraints(res, bmap);
+	res->flags = bmap->flags;
+	if (bmap->sample) {
+		res->sample = isl_vec_dup_to_ctx(bmap->sample, ctx);
+		if (!res->sample)
+			return isl_basic_map_free(res);
+	}
+
+	return res;
+}
+
+/* Return a copy of "bmap" that lives in "ctx".
+ * If "bmap" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_basic_map *isl_basic_map_transfer(
+	__isl_take isl_basic_map *bmap, isl_ctx *ctx)
+{
+	isl_basic_map *res;
+
+	if (!bmap || !ctx)
+		return isl_basic_map_free(bmap);
+	if (bmap->ctx == ctx)
+		return bmap;
+
+	res = basic_map_dup_to_ctx(bmap, ctx);
+	isl_basic_map_free(bmap);
+	return res;
+}
+
+__isl_give isl_basic_set *isl_basic_set_transfer(
+	__isl_take isl_basic_set *bset, isl_ctx *ctx)
+{
+	return isl_basic_map_transfer(bset, ctx);
+}
+
 struct isl_basic_set *isl_basic_set_dup(struct isl_basic_set *bset)
 {
 	struct isl_basic_map *dup;
@@ -1082,7 +1138,7 @@ struct isl_basic_set *isl_basic_set_copy(struct isl_basic_set *bset)
 		return NULL;
 
 	if (ISL_F_ISSET(bset, ISL_BASIC_SET_FINAL)) {
-		bset->ref++;
+		isl_refcount_inc(bset->ref);
 		return bset;
 	}
 	return isl_basic_set_dup(bset);
@@ -1093,7 +1149,7 @@ struct isl_set *isl_set_copy(struct isl_set *set)
 	if (!set)
 		return NULL;
 
-	set->ref++;
+	isl_refcount_inc(set->ref);
 	return set;
 }
 
@@ -1103,7 +1159,7 @@ struct isl_basic_map *isl_basic_map_copy(struct isl_basic_map *bmap)
 		return NULL;
 
 	if (ISL_F_ISSET(bmap, ISL_BASIC_SET_FINAL)) {
-		bmap->ref++;
+		isl_refcount_inc(bmap->ref);
 		return bmap;
 	}
 	bmap = isl_basic_map_dup(bmap);
@@ -1117,7 +1173,7 @@ struct isl_map *isl_map_copy(struct isl_map *map)
 	if (!map)
 		return NULL;
 
-	map->ref++;
+	isl_refcount_inc(map->ref);
 	return map;
 }
 
@@ -1126,7 +1182,7 @@ __isl_null isl_basic_map *isl_basic_map_free(__isl_take isl_basic_map *bmap)
 	if (!bmap)
 		return NULL;
 
-	if (--bmap->ref > 0)
+	if (isl_refcount_dec(bmap->ref) > 0)
 		return NULL;
 
 	isl_ctx_deref(bmap->ctx);
@@ -1207,6 +1263,7 @@ int isl_basic_map_alloc_equality(struct isl_basic_map *bmap)
 	isl_assert(ctx, (bmap->eq - bmap->ineq) + bmap->n_eq <= bmap->c_size,
 			return -1);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NO_REDUNDANT);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NO_IMPLICIT);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_ALL_EQUALITIES);
@@ -1241,6 +1298,7 @@ int isl_basic_map_free_equality(struct isl_basic_map *bmap, unsigned n)
 		return -1;
 	isl_assert(bmap->ctx, n <= bmap->n_eq, return -1);
 	bmap->n_eq -= n;
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return 0;
 }
 
@@ -1255,6 +1313,7 @@ int isl_basic_map_drop_equality(struct isl_basic_map *bmap, unsigned pos)
 	if (!bmap)
 		return -1;
 	isl_assert(bmap->ctx, pos < bmap->n_eq, return -1);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 
 	if (pos != bmap->n_eq - 1) {
 		t = bmap->eq[pos];
@@ -1291,6 +1350,7 @@ void isl_basic_map_inequality_to_equality(
 	bmap->eq--;
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NO_REDUNDANT);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED_DIVS);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_ALL_EQUALITIES);
 }
@@ -1310,6 +1370,7 @@ int isl_basic_map_alloc_inequality(struct isl_basic_map *bmap)
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NO_IMPLICIT);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NO_REDUNDANT);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_ALL_EQUALITIES);
 	isl_seq_clr(bmap->ineq[bmap->n_ineq] +
 		      1 + isl_basic_map_total_dim(bmap),
@@ -1328,6 +1389,7 @@ int isl_basic_map_free_inequality(struct isl_basic_map *bmap, unsigned n)
 		return -1;
 	isl_assert(bmap->ctx, n <= bmap->n_ineq, return -1);
 	bmap->n_ineq -= n;
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return 0;
 }
 
@@ -1348,6 +1410,7 @@ int isl_basic_map_drop_inequality(struct isl_basic_map *bmap, unsigned pos)
 		bmap->ineq[pos] = bmap->ineq[bmap->n_ineq - 1];
 		bmap->ineq[bmap->n_ineq - 1] = t;
 		ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+		ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	}
 	bmap->n_ineq--;
 	return 0;
@@ -1417,6 +1480,7 @@ int isl_basic_map_alloc_div(struct isl_basic_map *bmap)
 		      1 + 1 + isl_basic_map_total_dim(bmap),
 		      bmap->extra - bmap->n_div);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED_DIVS);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return bmap->n_div++;
 }
 
@@ -1431,6 +1495,7 @@ int isl_basic_map_free_div(struct isl_basic_map *bmap, unsigned n)
 		return -1;
 	isl_assert(bmap->ctx, n <= bmap->n_div, return -1);
 	bmap->n_div -= n;
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return 0;
 }
 
@@ -1657,42 +1722,50 @@ struct isl_basic_set *isl_basic_set_cow(struct isl_basic_set *bset)
 		isl_basic_map_cow((struct isl_basic_map *)bset);
 }
 
+/* Return a version of "bmap" that can be modified.
+ * If "bmap" is shared, then the duplicate is constructed before
+ * the reference to "bmap" is released such that "bmap" is guaranteed
+ * to remain valid while it is being duplicated.
+ */
 struct isl_basic_map *isl_basic_map_cow(struct isl_basic_map *bmap)
 {
 	if (!bmap)
 		return NULL;
 
-	if (bmap->ref > 1) {
-		bmap->ref--;
-		bmap = isl_basic_map_dup(bmap);
+	if (isl_refcount_get(bmap->ref) > 1) {
+		struct isl_basic_map *dup = isl_basic_map_dup(bmap);
+		isl_basic_map_free(bmap);
+		bmap = dup;
 	}
 	if (bmap) {
 		ISL_F_CLR(bmap, ISL_BASIC_SET_FINAL);
 		ISL_F_CLR(bmap, ISL_BASIC_MAP_REDUCED_COEFFICIENTS);
+		ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	}
 	return bmap;
 }
 
 struct isl_set *isl_set_cow(struct isl_set *set)
 {
-	if (!set)
-		return NULL;
-
-	if (set->ref == 1)
-		return set;
-	set->ref--;
-	return isl_set_dup(set);
+	return (struct isl_set *) isl_map_cow((struct isl_map *) set);
 }
 
+/* Return a version of "map" that can be modified.
+ * If "map" is shared, then the duplicate is constructed before
+ * the reference to "map" is released.
+ */
 struct isl_map *isl_map_cow(struct isl_map *map)
 {
+	isl_map *dup;
+
 	if (!map)
 		return NULL;
 
-	if (map->ref == 1)
+	if (isl_refcount_get(map->ref) == 1)
 		return map;
-	map->ref--;
-	return isl_map_dup(map);
+	dup = isl_map_dup(map);
+	isl_map_free(map);
+	return dup;
 }
 
 static void swap_vars(struct isl_blk blk, isl_int *a,
@@ -1741,6 +1814,7 @@ static __isl_give isl_basic_map *isl_basic_map_swap_vars(
 	isl_blk_free(bmap->ctx, blk);
 
 	ISL_F_CLR(bmap, ISL_BASIC_SET_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_SET_SIMPLIFIED);
 	bmap = isl_basic_map_gauss(bmap, NULL);
 	return isl_basic_map_finalize(bmap);
 error:
@@ -1810,6 +1884,7 @@ void isl_basic_map_swap_div(struct isl_basic_map *bmap, int a, int b)
 	for (i = 0; i < bmap->n_div; ++i)
 		isl_int_swap(bmap->div[i][1+1+off+a], bmap->div[i][1+1+off+b]);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 }
 
 /* Eliminate the specified n dimensions starting at first from the
@@ -2057,6 +2132,7 @@ static __isl_give isl_basic_map *insert_bounds_on_div_from_ineq(
 	}
 
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return bmap;
 error:
 	isl_basic_map_free(bmap);
@@ -2577,6 +2653,7 @@ int isl_inequality_negate(struct isl_basic_map *bmap, unsigned pos)
 	isl_seq_neg(bmap->ineq[pos], bmap->ineq[pos], 1 + total);
 	isl_int_sub_ui(bmap->ineq[pos][0], bmap->ineq[pos][0], 1);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return 0;
 }
 
@@ -2704,7 +2781,7 @@ __isl_null isl_set *isl_set_free(__isl_take isl_set *set)
 	if (!set)
 		return NULL;
 
-	if (--set->ref > 0)
+	if (isl_refcount_dec(set->ref) > 0)
 		return NULL;
 
 	isl_ctx_deref(set->ctx);
@@ -3373,6 +3450,7 @@ __isl_give isl_basic_map *isl_basic_map_move_dims(
 		goto error;
 
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	bmap = isl_basic_map_gauss(bmap, NULL);
 	bmap = isl_basic_map_finalize(bmap);
 
@@ -5430,6 +5508,42 @@ struct isl_map *isl_map_dup(struct isl_map *map)
 	return dup;
 }
 
+/* Return a copy of "map" that lives in "ctx".
+ * If "map" already lives in "ctx", then it is returned unchanged.
+ * The basic maps are only read and not copied, since
+ * isl_basic_map_copy may allocate in the context of "map" and
+ * this function may be called from a thread that does not own
+ * that context.
+ */
+__isl_give isl_map *isl_map_transfer(__isl_take isl_map *map, isl_ctx *ctx)
+{
+	int i;
+	isl_space *space;
+	isl_map *res;
+
+	if (!map || !ctx)
+		return isl_map_free(map);
+	if (map->ctx == ctx)
+		return map;
+
+	space = isl_space_transfer(isl_space_copy(map->dim), ctx);
+	res = isl_map_alloc_space(space, map->n, map->flags);
+	for (i = 0; i < map->n; ++i) {
+		isl_basic_map *bmap;
+
+		bmap = basic_map_dup_to_ctx(map->p[i], ctx);
+		res = isl_map_add_basic_map(res, bmap);
+	}
+
+	isl_map_free(map);
+	return res;
+}
+
+__isl_give isl_set *isl_set_transfer(__isl_take isl_set *set, isl_ctx *ctx)
+{
+	return isl_map_transfer(set, ctx);
+}
+
 __isl_give isl_map *isl_map_add_basic_map(__isl_take isl_map *map,
 						__isl_take isl_basic_map *bmap)
 {
@@ -5460,7 +5574,7 @@ __isl_null isl_map *isl_map_free(__isl_take isl_map *map)
 	if (!map)
 		return NULL;
 
-	if (--map->ref > 0)
+	if (isl_refcount_dec(map->ref) > 0)
 		return NULL;
 
 	isl_ctx_deref(map->ctx);
@@ -11283,6 +11397,7 @@ __isl_give isl_basic_map *isl_basic_map_realign(__isl_take isl_basic_map *bmap,
 	flags = bmap->flags;
 	ISL_FL_CLR(flags, ISL_BASIC_MAP_FINAL);
 	ISL_FL_CLR(flags, ISL_BASIC_MAP_NORMALIZED);
+	ISL_FL_CLR(flags, ISL_BASIC_MAP_SIMPLIFIED);
 	ISL_FL_CLR(flags, ISL_BASIC_MAP_NORMALIZED_DIVS);
 	res = isl_basic_map_alloc_space(dim,
 			bmap->n_div, bmap->n_eq, bmap->n_ineq);
@@ -11336,6 +11451,31 @@ error:
 	return NULL;
 }
 
+/* Reorder the dimensions of "map" according to "r",
+ * unless "r" is the identity reordering, in which case
+ * "map" is returned unchanged.
+ * The identity case arises when "map" is aligned to a parameter
+ * space that forms a prefix of that of "map".
+ */
+static __isl_give isl_map *map_realign_non_identity(
+	__isl_take isl_map *map, __isl_take isl_reordering *r)
+{
+	isl_bool identity;
+
+	identity = isl_reordering_is_identity(r);
+	if (identity < 0)
+		goto error;
+	if (identity) {
+		isl_reordering_free(r);
+		return map;
+	}
+	return isl_map_realign(map, r);
+error:
+	isl_map_free(map);
+	isl_reordering_free(r);
+	return NULL;
+}
+
 __isl_give isl_set *isl_set_realign(__isl_take isl_set *set,
 	__isl_take isl_reordering *r)
 {
@@ -11366,7 +11506,7 @@ __isl_give isl_map *isl_map_align_params(__isl_take isl_map *map,
 					0, isl_space_dim(model, isl_dim_out));
 		exp = isl_parameter_alignment_reordering(map->dim, model);
 		exp = isl_reordering_extend_space(exp, isl_map_get_space(map));
-		map = isl_map_realign(map, exp);
+		map = map_realign_non_identity(map, exp);
 	}
 
 	isl_space_free(model);
@@ -11383,6 +11523,36 @@ __isl_give isl_set *isl_set_align_params(__isl_take isl_set *set,
 	return isl_map_align_params(set, model);
 }
 
+/* Reorder the dimensions of "bmap" according to "exp",
+ * unless "exp" is the identity reordering, in which case
+ * "bmap" is returned unchanged.
+ */
+static __isl_give isl_basic_map *basic_map_realign_non_identity(
+	__isl_take isl_basic_map *bmap, __isl_take isl_reordering *exp)
+{
+	isl_bool identity;
+	struct isl_dim_map *dim_map;
+
+	identity = isl_reordering_is_identity(exp);
+	if (identity < 0)
+		goto error;
+	if (identity) {
+		isl_reordering_free(exp);
+		return bmap;
+	}
+
+	dim_map = isl_dim_map_from_reordering(exp);
+	bmap = isl_basic_map_realign(bmap, isl_space_copy(exp->dim),
+				    isl_dim_map_extend(dim_map, bmap));
+	isl_reordering_free(exp);
+	free(dim_map);
+	return bmap;
+error:
+	isl_basic_map_free(bmap);
+	isl_reordering_free(exp);
+	return NULL;
+}
+
 /* Align the parameters of "bmap" to those of "model", introducing
  * additional parameters if needed.
  */
@@ -11403,7 +11573,6 @@ __isl_give isl_basic_map *isl_basic_map_align_params(
 			"relation has unnamed parameters", goto error);
 	if (!isl_space_match(bmap->dim, isl_dim_param, model, isl_dim_param)) {
 		isl_reordering *exp;
-		struct isl_dim_map *dim_map;
 
 		model = isl_space_drop_dims(model, isl_dim_in,
 					0, isl_space_dim(model, isl_dim_in));
@@ -11412,12 +11581,7 @@ __isl_give isl_basic_map *isl_basic_map_align_params(
 		exp = isl_parameter_alignment_reordering(bmap->dim, model);
 		exp = isl_reordering_extend_space(exp,
 					isl_basic_map_get_space(bmap));
-		dim_map = isl_dim_map_from_reordering(exp);
-		bmap = isl_basic_map_realign(bmap,
-				    exp ? isl_space_copy(exp->dim) : NULL,
-				    isl_dim_map_extend(dim_map, bmap));
-		isl_reordering_free(exp);
-		free(dim_map);
+		bmap = basic_map_realign_non_identity(bmap, exp);
 	}
 
 	isl_space_free(model);
@@ -44,6 +44,7 @@ struct isl_basic_map {
 #define ISL_BASIC_MAP_NORMALIZED_DIVS	(1 << 6)
 #define ISL_BASIC_MAP_ALL_EQUALITIES	(1 << 7)
 #define ISL_BASIC_MAP_REDUCED_COEFFICIENTS	(1 << 8)
+#define ISL_BASIC_MAP_SIMPLIFIED	(1 << 9)
 #define ISL_BASIC_SET_FINAL		(1 << 0)
 #define ISL_BASIC_SET_EMPTY		(1 << 1)
 #define ISL_BASIC_SET_NO_IMPLICIT	(1 << 2)
@@ -53,6 +54,7 @@ struct isl_basic_map {
 #define ISL_BASIC_SET_NORMALIZED_DIVS	(1 << 6)
 #define ISL_BASIC_SET_ALL_EQUALITIES	(1 << 7)
 #define ISL_BASIC_SET_REDUCED_COEFFICIENTS	(1 << 8)
+#define ISL_BASIC_SET_SIMPLIFIED	(1 << 9)
 	unsigned flags;
 
 	struct isl_ctx *ctx;
@@ -473,6 +475,10 @@ int isl_basic_set_dim_residue_class(struct isl_basic_set *bset,
 int isl_set_dim_residue_class(struct isl_set *set,
 	int pos, isl_int *modulo, isl_int *residue);
 
+int isl_basic_set_n_generators_bound(__isl_keep isl_basic_set *bset, int max);
+__isl_give isl_basic_set *isl_basic_set_coefficients_from_generators(
+	__isl_take isl_basic_set *bset);
+
 __isl_give isl_basic_set *isl_basic_set_fix(__isl_take isl_basic_set *bset,
 	enum isl_dim_type type, unsigned pos, isl_int value);
 __isl_give isl_basic_map *isl_basic_map_fix(__isl_take isl_basic_map *bmap,
@@ -86,6 +86,7 @@ struct isl_basic_set *isl_basic_set_drop_dims(
 		goto error;
 
 	ISL_F_CLR(bset, ISL_BASIC_SET_NORMALIZED);
+	ISL_F_CLR(bset, ISL_BASIC_SET_SIMPLIFIED);
 	bset = isl_basic_set_simplify(bset);
 	return isl_basic_set_finalize(bset);
 error:
@@ -202,6 +203,7 @@ struct isl_basic_map *isl_basic_map_drop(struct isl_basic_map *bmap,
 		goto error;
 
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	bmap = isl_basic_map_simplify(bmap);
 	return isl_basic_map_finalize(bmap);
 error:
@@ -307,6 +309,7 @@ static struct isl_basic_map *isl_basic_map_drop_div(
 		bmap->div[bmap->n_div - 1] = t;
 	}
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	isl_basic_map_free_div(bmap, 1);
 
 	return bmap;
@@ -543,6 +546,7 @@ static void eliminate_var_using_equality(struct isl_basic_map *bmap,
 		isl_seq_elim(bmap->ineq[k], eq, 1+pos, 1+total, NULL);
 		isl_seq_normalize(bmap->ctx, bmap->ineq[k], 1 + total);
 		ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+		ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	}
 
 	for (k = 0; k < bmap->n_div; ++k) {
@@ -566,6 +570,7 @@ static void eliminate_var_using_equality(struct isl_basic_map *bmap,
 		} else
 			isl_seq_clr(bmap->div[k], 1 + total);
 		ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+		ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	}
 }
 
@@ -729,6 +734,7 @@ struct isl_basic_map *isl_basic_map_gauss(
 			if (progress)
 				*progress = 1;
 			ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+			ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 		}
 	}
 	if (done == bmap->n_eq)
@@ -1477,11 +1483,25 @@ static __isl_give isl_basic_map *eliminate_unit_divs(
 	return bmap;
 }
 
+/* Simplify "bmap" by repeatedly applying a sequence of cheap
+ * simplification steps until none of them makes any further progress.
+ *
+ * If "bmap" has already been simplified and has not been modified since,
+ * as indicated by the ISL_BASIC_MAP_SIMPLIFIED flag, then applying
+ * the steps again would not make any progress and they are skipped.
+ * The flag is cleared by isl_basic_map_cow and by any operation
+ * that changes the constraints or integer divisions of "bmap".
+ */
 struct isl_basic_map *isl_basic_map_simplify(struct isl_basic_map *bmap)
 {
 	int progress = 1;
 	if (!bmap)
 		return NULL;
+	bmap->ctx->stats->simplify_calls++;
+	if (ISL_F_ISSET(bmap, ISL_BASIC_MAP_SIMPLIFIED)) {
+		bmap->ctx->stats->simplify_skipped++;
+		return bmap;
+	}
 	while (progress) {
 		progress = 0;
 		if (!bmap)
@@ -1503,6 +1523,8 @@ struct isl_basic_map *isl_basic_map_simplify(struct isl_basic_map *bmap)
 		if (bmap && progress)
 			ISL_F_CLR(bmap, ISL_BASIC_MAP_REDUCED_COEFFICIENTS);
 	}
+	if (bmap)
+		ISL_F_SET(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	return bmap;
 }
 
@@ -1788,6 +1810,7 @@ struct isl_basic_map *isl_basic_map_eliminate_vars(
 		}
 	}
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	if (need_gauss)
 		bmap = isl_basic_map_gauss(bmap, NULL);
 	return bmap;
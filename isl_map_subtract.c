@@ -252,12 +252,73 @@ static int n_non_redundant(isl_ctx *ctx, struct isl_tab *tab,
 /* basic_map_collect_diff calls add on each of the pieces of
  * the set difference between bmap and map until the add method
  * return a negative value.
+ *
+ * If "witness" is not NULL, then the caller is only interested
+ * in whether the set difference is empty.  basic_map_collect_diff
+ * may then call "witness" instead of "add" as soon as it has found
+ * an integer point in the set difference, without constructing
+ * the corresponding piece.
  */
 struct isl_diff_collector {
 	int (*add)(struct isl_diff_collector *dc,
 		    __isl_take isl_basic_map *bmap);
+	int (*witness)(struct isl_diff_collector *dc);
 };
 
+/* Is the current sample value of "tab" an integer point
+ * in the set represented by "tab"?
+ * If so, then it is a witness for the non-emptiness of this set.
+ * The divs of the subtracted basic maps have been added to "tab"
+ * together with their defining constraints, so an integer sample value
+ * assigns the correct values to these divs.
+ */
+static isl_bool tab_has_integer_witness(struct isl_tab *tab)
+{
+	if (!tab)
+		return isl_bool_error;
+	if (tab->empty)
+		return isl_bool_false;
+	return isl_tab_sample_is_integer(tab);
+}
+
+/* Pass the piece of the set difference represented by "tab"
+ * to the collector "dc".
+ *
+ * If the collector is only interested in the non-emptiness
+ * of the set difference and if the current sample value of "tab"
+ * is already known to be an integer point, then the piece is non-empty
+ * and there is no need to construct it.
+ * Otherwise, the piece is extracted from "tab", simplified and
+ * passed to dc->add if it turns out to be non-empty.
+ */
+static int collect_piece(struct isl_tab *tab, struct isl_diff_collector *dc)
+{
+	isl_bool empty;
+	isl_basic_map *bm;
+
+	if (dc->witness) {
+		isl_bool witness = tab_has_integer_witness(tab);
+		if (witness < 0)
+			return -1;
+		if (witness)
+			return dc->witness(dc);
+	}
+
+	bm = isl_basic_map_copy(tab->bmap);
+	bm = isl_basic_map_cow(bm);
+	bm = isl_basic_map_update_from_tab(bm, tab);
+	bm = isl_basic_map_simplify(bm);
+	bm = isl_basic_map_finalize(bm);
+	empty = isl_basic_map_is_empty(bm);
+	if (empty)
+		isl_basic_map_free(bm);
+	else if (dc->add(dc, bm) < 0)
+		return -1;
+	if (empty < 0)
+		return -1;
+	return 0;
+}
+
 /* Compute the set difference between bmap and map and call
  * dc->add on each of the piece until this function returns
  * a negative value.
@@ -283,7 +344,8 @@ struct isl_diff_collector {
  * piece is a subset of the current basic map, then we simply backtrack.
  *
  * In the leaves, we check if the remaining piece has any integer points
- * and if so, pass it along to dc->add.  As a special case, if nothing
+ * and if so, pass it along to dc->add (or dc->witness, see collect_piece).
+ * As a special case, if nothing
  * has been removed when we end up in a leaf, we simply pass along
  * the original basic map.
  */
@@ -338,24 +400,12 @@ static isl_stat basic_map_collect_diff(__isl_take isl_basic_map *bmap,
 
 	while (level >= 0) {
 		if (level >= map->n) {
-			int empty;
-			struct isl_basic_map *bm;
 			if (!modified) {
 				if (dc->add(dc, isl_basic_map_copy(bmap)) < 0)
 					goto error;
 				break;
 			}
-			bm = isl_basic_map_copy(tab->bmap);
-			bm = isl_basic_map_cow(bm);
-			bm = isl_basic_map_update_from_tab(bm, tab);
-			bm = isl_basic_map_simplify(bm);
-			bm = isl_basic_map_finalize(bm);
-			empty = isl_basic_map_is_empty(bm);
-			if (empty)
-				isl_basic_map_free(bm);
-			else if (dc->add(dc, bm) < 0)
-				goto error;
-			if (empty < 0)
+			if (collect_piece(tab, dc) < 0)
 				goto error;
 			level--;
 			init = 0;
@@ -483,6 +533,7 @@ static __isl_give isl_map *basic_map_subtract(__isl_take isl_basic_map *bmap,
 {
 	struct isl_subtract_diff_collector sdc;
 	sdc.dc.add = &basic_map_subtract_add;
+	sdc.dc.witness = NULL;
 	sdc.diff = isl_map_empty(isl_basic_map_get_space(bmap));
 	if (basic_map_collect_diff(bmap, map, &sdc.dc) < 0) {
 		isl_map_free(sdc.diff);
@@ -654,8 +705,24 @@ static int basic_map_is_empty_add(struct isl_diff_collector *dc,
 	return -1;
 }
 
+/* isl_is_empty_diff_collector witness callback.
+ * An integer point has been found in the set difference,
+ * so it is not empty.
+ */
+static int basic_map_is_empty_witness(struct isl_diff_collector *dc)
+{
+	struct isl_is_empty_diff_collector *edc;
+	edc = (struct isl_is_empty_diff_collector *)dc;
+
+	edc->empty = 0;
+
+	return -1;
+}
+
 /* Check if bmap \ map is empty by computing this set difference
- * and breaking off as soon as the difference is known to be non-empty.
+ * and breaking off as soon as the difference is known to be non-empty,
+ * i.e., as soon as a first piece or a first witness point
+ * of the set difference has been found.
  */
 static isl_bool basic_map_diff_is_empty(__isl_keep isl_basic_map *bmap,
 	__isl_keep isl_map *map)
@@ -669,6 +736,7 @@ static isl_bool basic_map_diff_is_empty(__isl_keep isl_basic_map *bmap,
 		return empty;
 
 	edc.dc.add = &basic_map_is_empty_add;
+	edc.dc.witness = &basic_map_is_empty_witness;
 	edc.empty = isl_bool_true;
 	r = basic_map_collect_diff(isl_basic_map_copy(bmap),
 				   isl_map_copy(map), &edc.dc);
@@ -873,6 +941,7 @@ __isl_give isl_map *isl_map_make_disjoint(__isl_take isl_map *map)
 	int i;
 	struct isl_subtract_diff_collector sdc;
 	sdc.dc.add = &basic_map_subtract_add;
+	sdc.dc.witness = NULL;
 
 	if (!map)
 		return NULL;
@@ -218,6 +218,25 @@ struct isl_mat *isl_mat_dup(struct isl_mat *mat)
 	return mat2;
 }
 
+/* Return a copy of "mat" that lives in "ctx".
+ * Only the elements of "mat" are read, such that "mat" may be
+ * duplicated from a thread other than the one that owns its context.
+ */
+__isl_give isl_mat *isl_mat_dup_to_ctx(__isl_keep isl_mat *mat, isl_ctx *ctx)
+{
+	int i;
+	isl_mat *dup;
+
+	if (!mat)
+		return NULL;
+	dup = isl_mat_alloc(ctx, mat->n_row, mat->n_col);
+	if (!dup)
+		return NULL;
+	for (i = 0; i < mat->n_row; ++i)
+		isl_seq_cpy(dup->row[i], mat->row[i], mat->n_col);
+	return dup;
+}
+
 struct isl_mat *isl_mat_cow(struct isl_mat *mat)
 {
 	struct isl_mat *mat2;
@@ -1194,6 +1213,7 @@ struct isl_basic_set *isl_basic_set_preimage(struct isl_basic_set *bset,
 	ISL_F_CLR(bset, ISL_BASIC_SET_NO_IMPLICIT);
 	ISL_F_CLR(bset, ISL_BASIC_SET_NO_REDUNDANT);
 	ISL_F_CLR(bset, ISL_BASIC_SET_NORMALIZED);
+	ISL_F_CLR(bset, ISL_BASIC_SET_SIMPLIFIED);
 	ISL_F_CLR(bset, ISL_BASIC_SET_NORMALIZED_DIVS);
 	ISL_F_CLR(bset, ISL_BASIC_SET_ALL_EQUALITIES);
 
@@ -1295,6 +1315,7 @@ __isl_give isl_basic_map *isl_basic_map_transform_dims(
 		goto error;
 
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED);
+	ISL_F_CLR(bmap, ISL_BASIC_MAP_SIMPLIFIED);
 	ISL_F_CLR(bmap, ISL_BASIC_MAP_NORMALIZED_DIVS);
 
 	isl_mat_free(trans);
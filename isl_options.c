@@ -13,6 +13,8 @@
 
 #include <isl/ctx.h>
 #include <isl_options_private.h>
+#include <isl_ctx_private.h>
+#include <isl_closure_cache.h>
 #include <isl/ast_build.h>
 #include <isl/schedule.h>
 #include <isl/version.h>
@@ -117,6 +119,10 @@ ISL_ARG_CHOICE(struct isl_options, gbr, 0, "gbr", \
 ISL_ARG_CHOICE(struct isl_options, closure, 0, "closure", \
 	isl_closure_choice,	ISL_CLOSURE_ISL,
 	"closure operation to use")
+ISL_ARG_INT(struct isl_options, closure_cache_size, 0,
+	"closure-cache-size", "size", 0, "maximal number of transitive "
+	"closure and power results kept in the closure cache. "
+	"A value of 0 disables the cache.")
 ISL_ARG_BOOL(struct isl_options, gbr_only_first, 0, "gbr-only-first", 0,
 	"only perform basis reduction in first direction")
 ISL_ARG_CHOICE(struct isl_options, bound, 0, "bound", bound,
@@ -172,6 +178,20 @@ ISL_ARG_CHOICE(struct isl_options, schedule_algorithm, 0,
 ISL_ARG_BOOL(struct isl_options, schedule_serialize_sccs, 0,
 	"schedule-serialize-sccs", 0,
 	"serialize strongly connected components in dependence graph")
+ISL_ARG_BOOL(struct isl_options, schedule_concurrent_components, 0,
+	"schedule-concurrent-components", 0,
+	"schedule independent components as concurrent tasks")
+ISL_ARG_BOOL(struct isl_options, schedule_concurrent_merge, 0,
+	"schedule-concurrent-merge", 0,
+	"compute schedules for merge candidates as concurrent tasks")
+ISL_ARG_INT(struct isl_options, schedule_budget, 0,
+	"schedule-budget", "ms", 0,
+	"time in milliseconds after which the scheduler falls back "
+	"to a cheaper algorithm (0 means no limit)")
+ISL_ARG_INT(struct isl_options, schedule_max_generators, 0,
+	"schedule-max-generators", "n", 0,
+	"compute the dual of a dependence relation from its generators "
+	"if it has at most this many (0 means always use Farkas' lemma)")
 ISL_ARG_PHANTOM_USER_CHOICE_F(0, "schedule-fuse", fuse, &set_fuse,
 	ISL_SCHEDULE_FUSE_MAX, "level of fusion during scheduling",
 	ISL_ARG_HIDDEN)
@@ -214,11 +234,36 @@ ISL_ARG_BOOL(struct isl_options, print_stats, 0, "print-stats", 0,
 	"print statistics for every isl_ctx")
 ISL_ARG_ULONG(struct isl_options, max_operations, 0,
 	"max-operations", 0, "default number of maximal operations per isl_ctx")
+ISL_ARG_INT(struct isl_options, thread_pool_size, 0,
+	"thread-pool-size", "size", 0,
+	"number of worker threads used by isl_ctx_run_tasks "
+	"(0 or 1 means tasks are run sequentially)")
 ISL_ARG_VERSION(print_version)
 ISL_ARGS_END
 
 ISL_ARG_DEF(isl_options, struct isl_options, isl_options_args)
 
+/* Return a copy of "opt".
+ * The only field that does not simply get copied over
+ * is the string option ast_iterator_type.
+ */
+struct isl_options *isl_options_dup(struct isl_options *opt)
+{
+	struct isl_options *dup;
+
+	if (!opt)
+		return NULL;
+	dup = isl_options_new_with_defaults();
+	if (!dup)
+		return NULL;
+	free(dup->ast_iterator_type);
+	*dup = *opt;
+	dup->ast_iterator_type = NULL;
+	if (opt->ast_iterator_type)
+		dup->ast_iterator_type = strdup(opt->ast_iterator_type);
+	return dup;
+}
+
 ISL_ARG_CTX_DEF(isl_options, struct isl_options, isl_options_args)
 
 ISL_CTX_SET_CHOICE_DEF(isl_options, struct isl_options, isl_options_args, bound)
@@ -239,6 +284,31 @@ ISL_CTX_SET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
 ISL_CTX_GET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
 	gbr_only_first)
 
+/* Set the maximal number of results in the closure cache of "ctx"
+ * to "val", evicting the least recently used results
+ * if the cache currently holds more.
+ */
+isl_stat isl_options_set_closure_cache_size(isl_ctx *ctx, int val)
+{
+	struct isl_options *options;
+
+	options = isl_ctx_peek_isl_options(ctx);
+	if (!options)
+		isl_die(ctx, isl_error_invalid,
+			"isl_ctx does not reference isl_options",
+			return isl_stat_error);
+	options->closure_cache_size = val;
+	isl_closure_cache_trim(ctx->closure_cache, val);
+	return isl_stat_ok;
+}
+ISL_CTX_GET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	closure_cache_size)
+
+ISL_CTX_SET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	thread_pool_size)
+ISL_CTX_GET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	thread_pool_size)
+
 ISL_CTX_SET_INT_DEF(isl_options, struct isl_options, isl_options_args,
 	schedule_max_coefficient)
 ISL_CTX_GET_INT_DEF(isl_options, struct isl_options, isl_options_args,
@@ -294,6 +364,26 @@ ISL_CTX_SET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
 ISL_CTX_GET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
 	schedule_serialize_sccs)
 
+ISL_CTX_SET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_concurrent_components)
+ISL_CTX_GET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_concurrent_components)
+
+ISL_CTX_SET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_concurrent_merge)
+ISL_CTX_GET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_concurrent_merge)
+
+ISL_CTX_SET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_budget)
+ISL_CTX_GET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_budget)
+
+ISL_CTX_SET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_max_generators)
+ISL_CTX_GET_INT_DEF(isl_options, struct isl_options, isl_options_args,
+	schedule_max_generators)
+
 ISL_CTX_SET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
 	tile_scale_tile_loops)
 ISL_CTX_GET_BOOL_DEF(isl_options, struct isl_options, isl_options_args,
@@ -17,6 +17,7 @@ struct isl_options {
 	#define			ISL_CLOSURE_ISL		0
 	#define			ISL_CLOSURE_BOX		1
 	unsigned		closure;
+	int			closure_cache_size;
 
 	int			bound;
 	unsigned		on_error;
@@ -47,6 +48,10 @@ struct isl_options {
 	int			schedule_whole_component;
 	unsigned		schedule_algorithm;
 	int			schedule_serialize_sccs;
+	int			schedule_concurrent_components;
+	int			schedule_concurrent_merge;
+	int			schedule_budget;
+	int			schedule_max_generators;
 
 	int			tile_scale_tile_loops;
 	int			tile_shift_point_loops;
@@ -67,6 +72,10 @@ struct isl_options {
 
 	int			print_stats;
 	unsigned long		max_operations;
+
+	int			thread_pool_size;
 };
 
+struct isl_options *isl_options_dup(struct isl_options *opt);
+
 #endif
@@ -0,0 +1,26 @@
+#ifndef ISL_REFCOUNT_H
+#define ISL_REFCOUNT_H
+
+#include <isl_config.h>
+
+/* Update and read the reference count "ref" of an object.
+ *
+ * By default, reference counts are plain integers since every object
+ * is only ever used from the thread that owns its isl_ctx.
+ * If isl is configured with --enable-atomic-refcount, then
+ * the reference counts of isl_ctx, isl_id, isl_space, isl_basic_map,
+ * isl_map and isl_union_map are updated atomically instead,
+ * such that copies of these objects can be taken and released
+ * from several threads at the same time.
+ */
+#ifdef ISL_ATOMIC_REFCOUNT
+#define isl_refcount_inc(ref)	__atomic_add_fetch(&(ref), 1, __ATOMIC_RELAXED)
+#define isl_refcount_dec(ref)	__atomic_sub_fetch(&(ref), 1, __ATOMIC_ACQ_REL)
+#define isl_refcount_get(ref)	__atomic_load_n(&(ref), __ATOMIC_ACQUIRE)
+#else
+#define isl_refcount_inc(ref)	(++(ref))
+#define isl_refcount_dec(ref)	(--(ref))
+#define isl_refcount_get(ref)	(ref)
+#endif
+
+#endif
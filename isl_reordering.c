@@ -82,6 +82,29 @@ void *isl_reordering_free(__isl_take isl_reordering *exp)
 	return NULL;
 }
 
+/* Is "exp" the identity reordering?
+ * That is, does it map each dimension to the same position
+ * without introducing any extra dimensions?
+ * This is the case for a parameter alignment reordering if
+ * the parameters of the aligner appear in the same order
+ * at the start of the parameters of the alignee.
+ */
+isl_bool isl_reordering_is_identity(__isl_keep isl_reordering *exp)
+{
+	int i;
+
+	if (!exp || !exp->dim)
+		return isl_bool_error;
+
+	if (exp->len != isl_space_dim(exp->dim, isl_dim_all))
+		return isl_bool_false;
+	for (i = 0; i < exp->len; ++i)
+		if (exp->pos[i] != i)
+			return isl_bool_false;
+
+	return isl_bool_true;
+}
+
 /* Construct a reordering that maps the parameters of "alignee"
  * to the corresponding parameters in a new dimension specification
  * that has the parameters of "aligner" first, followed by
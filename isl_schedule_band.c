@@ -13,6 +13,7 @@
 #include <string.h>
 #include <isl/map.h>
 #include <isl/schedule_node.h>
+#include <isl_aff_private.h>
 #include <isl_schedule_band.h>
 #include <isl_schedule_private.h>
 
@@ -173,6 +174,36 @@ __isl_null isl_schedule_band *isl_schedule_band_free(
 	return NULL;
 }
 
+/* Return a copy of "band" that lives in "ctx".
+ * The partial schedule and the AST build options are transferred
+ * using the corresponding *_transfer functions.
+ * If "band" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_schedule_band *isl_schedule_band_transfer(
+	__isl_take isl_schedule_band *band, isl_ctx *ctx)
+{
+	int anchored;
+
+	if (!band || !ctx)
+		return isl_schedule_band_free(band);
+	if (isl_schedule_band_get_ctx(band) == ctx)
+		return band;
+
+	anchored = band->anchored;
+	band = isl_schedule_band_cow(band);
+	if (!band)
+		return NULL;
+
+	band->anchored = anchored;
+	band->mupa = isl_multi_union_pw_aff_transfer(band->mupa, ctx);
+	band->ast_build_options =
+		isl_union_set_transfer(band->ast_build_options, ctx);
+	if (!band->mupa || !band->ast_build_options)
+		return isl_schedule_band_free(band);
+
+	return band;
+}
+
 /* Are "band1" and "band2" obviously equal?
  */
 isl_bool isl_schedule_band_plain_is_equal(__isl_keep isl_schedule_band *band1,
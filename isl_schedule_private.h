@@ -1,6 +1,7 @@
 #ifndef ISL_SCHEDLUE_PRIVATE_H
 #define ISL_SCHEDLUE_PRIVATE_H
 
+#include <isl/stdint.h>
 #include <isl/aff.h>
 #include <isl/schedule.h>
 #include <isl_schedule_tree.h>
@@ -38,4 +39,7 @@ __isl_give isl_union_set *isl_schedule_get_domain(
 __isl_keep isl_schedule_tree *isl_schedule_peek_leaf(
 	__isl_keep isl_schedule *schedule);
 
+__isl_give isl_schedule *isl_schedule_constraints_compute_schedule_before(
+	__isl_take isl_schedule_constraints *sc, uint64_t deadline);
+
 #endif
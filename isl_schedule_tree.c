@@ -10,7 +10,9 @@
  * B.P. 105 - 78153 Le Chesnay, France
  */
 
+#include <isl/id.h>
 #include <isl/map.h>
+#include <isl_aff_private.h>
 #include <isl_schedule_band.h>
 #include <isl_schedule_private.h>
 
@@ -214,6 +216,116 @@ __isl_null isl_schedule_tree *isl_schedule_tree_free(
 	return NULL;
 }
 
+/* Return a copy of the list of children "list" that lives in "ctx",
+ * with each of the children transferred to "ctx".
+ */
+static __isl_give isl_schedule_tree_list *children_transfer(
+	__isl_take isl_schedule_tree_list *list, isl_ctx *ctx)
+{
+	int i, n;
+	isl_schedule_tree_list *res;
+
+	if (!list)
+		return NULL;
+
+	n = isl_schedule_tree_list_n_schedule_tree(list);
+	res = isl_schedule_tree_list_alloc(ctx, n);
+	for (i = 0; i < n; ++i) {
+		isl_schedule_tree *child;
+
+		child = isl_schedule_tree_list_get_schedule_tree(list, i);
+		child = isl_schedule_tree_transfer(child, ctx);
+		res = isl_schedule_tree_list_add(res, child);
+	}
+
+	isl_schedule_tree_list_free(list);
+	return res;
+}
+
+/* Return a copy of "tree" that lives in "ctx".
+ * The node specific fields and the children are transferred
+ * using the corresponding *_transfer functions.
+ * If "tree" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_schedule_tree *isl_schedule_tree_transfer(
+	__isl_take isl_schedule_tree *tree, isl_ctx *ctx)
+{
+	if (!tree || !ctx)
+		return isl_schedule_tree_free(tree);
+	if (tree->ctx == ctx)
+		return tree;
+
+	tree = isl_schedule_tree_cow(tree);
+	if (!tree)
+		return NULL;
+
+	isl_ctx_deref(tree->ctx);
+	tree->ctx = ctx;
+	isl_ctx_ref(ctx);
+
+	switch (tree->type) {
+	case isl_schedule_node_error:
+		isl_die(ctx, isl_error_internal,
+			"invalid schedule tree", goto error);
+	case isl_schedule_node_band:
+		tree->band = isl_schedule_band_transfer(tree->band, ctx);
+		if (!tree->band)
+			goto error;
+		break;
+	case isl_schedule_node_context:
+		tree->context = isl_set_transfer(tree->context, ctx);
+		if (!tree->context)
+			goto error;
+		break;
+	case isl_schedule_node_domain:
+		tree->domain = isl_union_set_transfer(tree->domain, ctx);
+		if (!tree->domain)
+			goto error;
+		break;
+	case isl_schedule_node_expansion:
+		tree->contraction =
+		    isl_union_pw_multi_aff_transfer(tree->contraction, ctx);
+		tree->expansion = isl_union_map_transfer(tree->expansion, ctx);
+		if (!tree->contraction || !tree->expansion)
+			goto error;
+		break;
+	case isl_schedule_node_extension:
+		tree->extension = isl_union_map_transfer(tree->extension, ctx);
+		if (!tree->extension)
+			goto error;
+		break;
+	case isl_schedule_node_filter:
+		tree->filter = isl_union_set_transfer(tree->filter, ctx);
+		if (!tree->filter)
+			goto error;
+		break;
+	case isl_schedule_node_guard:
+		tree->guard = isl_set_transfer(tree->guard, ctx);
+		if (!tree->guard)
+			goto error;
+		break;
+	case isl_schedule_node_mark:
+		tree->mark = isl_id_transfer(tree->mark, ctx);
+		if (!tree->mark)
+			goto error;
+		break;
+	case isl_schedule_node_leaf:
+	case isl_schedule_node_sequence:
+	case isl_schedule_node_set:
+		break;
+	}
+
+	if (tree->children) {
+		tree->children = children_transfer(tree->children, ctx);
+		if (!tree->children)
+			goto error;
+	}
+
+	return tree;
+error:
+	return isl_schedule_tree_free(tree);
+}
+
 /* Create and return a new leaf schedule tree.
  */
 __isl_give isl_schedule_tree *isl_schedule_tree_leaf(isl_ctx *ctx)
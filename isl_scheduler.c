@@ -11,6 +11,7 @@
  * and Ecole Normale Superieure, 45 rue d'Ulm, 75230 Paris, France
  */
 
+#include <string.h>
 #include <isl_ctx_private.h>
 #include <isl_map_private.h>
 #include <isl_space_private.h>
@@ -19,6 +20,8 @@
 #include <isl/constraint.h>
 #include <isl/schedule.h>
 #include <isl/schedule_node.h>
+#include <isl/stream.h>
+#include <isl/printer.h>
 #include <isl_mat_private.h>
 #include <isl_vec_private.h>
 #include <isl/set.h>
@@ -30,9 +33,12 @@
 #include <isl_sort.h>
 #include <isl_options_private.h>
 #include <isl_tarjan.h>
+#include <isl_thread_pool.h>
 #include <isl_morph.h>
 #include <isl/ilp.h>
 #include <isl_val_private.h>
+#include <isl_schedule_node_private.h>
+#include <isl_schedule_private.h>
 
 /*
  * The scheduling algorithm implemented in this file was inspired by
@@ -452,6 +458,307 @@ void isl_schedule_constraints_dump(__isl_keep isl_schedule_constraints *sc)
 	isl_union_map_dump(sc->constraint[isl_edge_conditional_validity]);
 }
 
+/* An enumeration of the various keys that may appear in a YAML mapping
+ * of an isl_schedule_constraints object.
+ * The keys for the schedule constraints have the same value
+ * as the corresponding isl_edge_type.
+ */
+enum isl_sc_key {
+	isl_sc_key_error = -1,
+	isl_sc_key_validity = isl_edge_validity,
+	isl_sc_key_coincidence = isl_edge_coincidence,
+	isl_sc_key_condition = isl_edge_condition,
+	isl_sc_key_conditional_validity = isl_edge_conditional_validity,
+	isl_sc_key_proximity = isl_edge_proximity,
+	isl_sc_key_domain,
+	isl_sc_key_context,
+	isl_sc_key_end
+};
+
+/* The textual representations of the keys, in the order
+ * of enum isl_sc_key.
+ */
+static const char *sc_key_str[] = {
+	"validity",
+	"coincidence",
+	"condition",
+	"conditional_validity",
+	"proximity",
+	"domain",
+	"context",
+};
+
+/* Print a key-value pair of a YAML mapping to "p",
+ * with key "key" and value the quoted string representation of "umap".
+ */
+static __isl_give isl_printer *print_sc_union_map(__isl_take isl_printer *p,
+	const char *key, __isl_keep isl_union_map *umap)
+{
+	p = isl_printer_print_str(p, key);
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_print_str(p, "\"");
+	p = isl_printer_print_union_map(p, umap);
+	p = isl_printer_print_str(p, "\"");
+	p = isl_printer_yaml_next(p);
+
+	return p;
+}
+
+/* Print "sc" to "p" as a YAML mapping.
+ * The context is only printed if it is not obviously universal and
+ * the schedule constraints are only printed if they are not
+ * obviously empty, since these are the default values
+ * when reading an isl_schedule_constraints object.
+ */
+__isl_give isl_printer *isl_printer_print_schedule_constraints(
+	__isl_take isl_printer *p, __isl_keep isl_schedule_constraints *sc)
+{
+	enum isl_edge_type i;
+
+	if (!sc)
+		return isl_printer_free(p);
+
+	p = isl_printer_yaml_start_mapping(p);
+	p = isl_printer_print_str(p, sc_key_str[isl_sc_key_domain]);
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_print_str(p, "\"");
+	p = isl_printer_print_union_set(p, sc->domain);
+	p = isl_printer_print_str(p, "\"");
+	p = isl_printer_yaml_next(p);
+	if (!isl_set_plain_is_universe(sc->context)) {
+		p = isl_printer_print_str(p, sc_key_str[isl_sc_key_context]);
+		p = isl_printer_yaml_next(p);
+		p = isl_printer_print_str(p, "\"");
+		p = isl_printer_print_set(p, sc->context);
+		p = isl_printer_print_str(p, "\"");
+		p = isl_printer_yaml_next(p);
+	}
+	for (i = isl_edge_first; i <= isl_edge_last; ++i) {
+		if (isl_union_map_n_map(sc->constraint[i]) == 0)
+			continue;
+		p = print_sc_union_map(p, sc_key_str[i], sc->constraint[i]);
+	}
+	p = isl_printer_yaml_end_mapping(p);
+
+	return p;
+}
+
+/* Return a string representation of "sc" in block YAML format.
+ */
+__isl_give char *isl_schedule_constraints_to_str(
+	__isl_keep isl_schedule_constraints *sc)
+{
+	isl_printer *p;
+	char *s;
+
+	if (!sc)
+		return NULL;
+
+	p = isl_printer_to_str(isl_schedule_constraints_get_ctx(sc));
+	p = isl_printer_set_yaml_style(p, ISL_YAML_STYLE_BLOCK);
+	p = isl_printer_print_schedule_constraints(p, sc);
+	s = isl_printer_get_str(p);
+	isl_printer_free(p);
+
+	return s;
+}
+
+/* Read a key from "s" and return the corresponding enum.
+ * Return isl_sc_key_error on error, i.e., if the first token
+ * on the stream does not correspond to any known key.
+ */
+static enum isl_sc_key get_sc_key(__isl_keep isl_stream *s)
+{
+	struct isl_token *tok;
+	enum isl_sc_key key;
+	isl_ctx *ctx;
+	char *name;
+	int type;
+
+	ctx = isl_stream_get_ctx(s);
+	tok = isl_stream_next_token(s);
+	if (!tok) {
+		isl_stream_error(s, NULL, "unexpected EOF");
+		return isl_sc_key_error;
+	}
+	type = isl_token_get_type(tok);
+	if (type != ISL_TOKEN_IDENT && type != ISL_TOKEN_STRING) {
+		isl_stream_error(s, tok, "expecting key");
+		isl_token_free(tok);
+		return isl_sc_key_error;
+	}
+	name = isl_token_get_str(ctx, tok);
+	isl_token_free(tok);
+	if (!name)
+		return isl_sc_key_error;
+	for (key = 0; key < isl_sc_key_end; ++key)
+		if (!strcmp(name, sc_key_str[key]))
+			break;
+	free(name);
+	if (key >= isl_sc_key_end)
+		isl_die(ctx, isl_error_invalid, "unknown key",
+			return isl_sc_key_error);
+
+	return key;
+}
+
+/* Read the string representation of a value from "s".
+ */
+static __isl_give char *read_sc_value(__isl_keep isl_stream *s)
+{
+	struct isl_token *tok;
+	char *str;
+
+	tok = isl_stream_next_token(s);
+	if (!tok) {
+		isl_stream_error(s, NULL, "unexpected EOF");
+		return NULL;
+	}
+	str = isl_token_get_str(isl_stream_get_ctx(s), tok);
+	isl_token_free(tok);
+
+	return str;
+}
+
+/* Replace the schedule constraints of type "type" in "sc" by "c".
+ */
+static __isl_give isl_schedule_constraints *isl_schedule_constraints_set(
+	__isl_take isl_schedule_constraints *sc, enum isl_edge_type type,
+	__isl_take isl_union_map *c)
+{
+	if (!sc || !c)
+		goto error;
+
+	isl_union_map_free(sc->constraint[type]);
+	sc->constraint[type] = c;
+
+	return sc;
+error:
+	isl_schedule_constraints_free(sc);
+	isl_union_map_free(c);
+	return NULL;
+}
+
+/* Read an isl_schedule_constraints object from "s".
+ * The input is a YAML mapping with a required "domain" key and
+ * optional "context", "validity", "coincidence", "condition",
+ * "conditional_validity" and "proximity" keys.
+ * The value associated to each key is the (quoted) string representation
+ * of the corresponding set or relation.
+ * A missing context is taken to be the universe and
+ * missing constraints are taken to be empty.
+ * A value that cannot be parsed results in an error,
+ * rather than being treated as if the key were missing.
+ */
+__isl_give isl_schedule_constraints *isl_stream_read_schedule_constraints(
+	__isl_keep isl_stream *s)
+{
+	isl_ctx *ctx;
+	isl_schedule_constraints *sc;
+	isl_union_set *domain = NULL;
+	isl_set *context = NULL;
+	isl_union_map *c[isl_edge_last + 1] = { NULL };
+	enum isl_edge_type i;
+	int more;
+
+	if (!s)
+		return NULL;
+	ctx = isl_stream_get_ctx(s);
+	if (isl_stream_yaml_read_start_mapping(s) < 0)
+		return NULL;
+
+	while ((more = isl_stream_yaml_next(s)) > 0) {
+		enum isl_sc_key key;
+		char *str;
+		int ok;
+
+		key = get_sc_key(s);
+		if (key == isl_sc_key_error)
+			goto error;
+		if (isl_stream_yaml_next(s) < 0)
+			goto error;
+		str = read_sc_value(s);
+		if (!str)
+			goto error;
+		if (key == isl_sc_key_domain) {
+			isl_union_set_free(domain);
+			domain = isl_union_set_read_from_str(ctx, str);
+			ok = domain != NULL;
+		} else if (key == isl_sc_key_context) {
+			isl_set_free(context);
+			context = isl_set_read_from_str(ctx, str);
+			ok = context != NULL;
+		} else {
+			isl_union_map_free(c[key]);
+			c[key] = isl_union_map_read_from_str(ctx, str);
+			ok = c[key] != NULL;
+		}
+		free(str);
+		if (!ok)
+			goto error;
+	}
+	if (more < 0)
+		goto error;
+
+	if (isl_stream_yaml_read_end_mapping(s) < 0) {
+		isl_stream_error(s, NULL, "unexpected extra elements");
+		goto error;
+	}
+	if (!domain) {
+		isl_stream_error(s, NULL, "no domain specified");
+		goto error;
+	}
+
+	sc = isl_schedule_constraints_on_domain(domain);
+	if (context)
+		sc = isl_schedule_constraints_set_context(sc, context);
+	for (i = isl_edge_first; i <= isl_edge_last; ++i)
+		if (c[i])
+			sc = isl_schedule_constraints_set(sc, i, c[i]);
+
+	return sc;
+error:
+	isl_union_set_free(domain);
+	isl_set_free(context);
+	for (i = isl_edge_first; i <= isl_edge_last; ++i)
+		isl_union_map_free(c[i]);
+	return NULL;
+}
+
+/* Read an isl_schedule_constraints object from "input".
+ */
+__isl_give isl_schedule_constraints *isl_schedule_constraints_read_from_file(
+	isl_ctx *ctx, FILE *input)
+{
+	isl_stream *s;
+	isl_schedule_constraints *sc;
+
+	s = isl_stream_new_file(ctx, input);
+	if (!s)
+		return NULL;
+	sc = isl_stream_read_schedule_constraints(s);
+	isl_stream_free(s);
+
+	return sc;
+}
+
+/* Read an isl_schedule_constraints object from "str".
+ */
+__isl_give isl_schedule_constraints *isl_schedule_constraints_read_from_str(
+	isl_ctx *ctx, const char *str)
+{
+	isl_stream *s;
+	isl_schedule_constraints *sc;
+
+	s = isl_stream_new_str(ctx, str);
+	if (!s)
+		return NULL;
+	sc = isl_stream_read_schedule_constraints(s);
+	isl_stream_free(s);
+
+	return sc;
+}
+
 /* Align the parameters of the fields of "sc".
  */
 static __isl_give isl_schedule_constraints *
@@ -543,6 +850,11 @@ static __isl_give int isl_schedule_constraints_n_map(
  * schedule coefficients of the (compressed) variables.  If no bound
  * needs to be imposed on a particular variable, then the corresponding
  * value is negative.
+ *
+ * If the schedule is being recomputed from a previous schedule, then
+ * "fixed" may contain the rows of the outermost band of that schedule,
+ * in the same format as "sched".  Row i of "fixed" is then imposed
+ * on row i of the outermost band, as long as this remains valid.
  */
 struct isl_sched_node {
 	isl_space *space;
@@ -567,6 +879,8 @@ struct isl_sched_node {
 
 	isl_multi_val *sizes;
 	isl_vec *max;
+
+	isl_mat *fixed;
 };
 
 static int node_has_space(const void *entry, const void *val)
@@ -621,6 +935,15 @@ static int node_scc_at_least(struct isl_sched_node *node, int scc)
  * constraints in the LP problem that encode the validity constraint
  * corresponding to this edge.
  *
+ * "lp_coef" contains the constraints on the coefficients of valid
+ * affine functions over "map" that were used in the most recent LP
+ * problem constructed by setup_lp, i.e., with the coefficients
+ * of the variables written as linear combinations of the columns
+ * of the cmap of the source and sink.  "lp_map", "lp_src_cmap" and
+ * "lp_dst_cmap" are the dependence relation and the cmaps from which
+ * "lp_coef" was computed.  References to these objects are kept
+ * such that they can be compared by pointer to the current values.
+ *
  * During clustering, an edge may be marked "no_merge" if it should
  * not be used to merge clusters.
  * The weight is also only used during clustering and it is
@@ -644,6 +967,11 @@ struct isl_sched_edge {
 	int start;
 	int end;
 
+	isl_map *lp_map;
+	isl_mat *lp_src_cmap;
+	isl_mat *lp_dst_cmap;
+	isl_basic_set *lp_coef;
+
 	int no_merge;
 	int weight;
 };
@@ -732,16 +1060,146 @@ static int is_conditional_validity(struct isl_sched_edge *edge)
 	return is_type(edge, isl_edge_conditional_validity);
 }
 
-/* Internal information about the dependence graph used during
- * the construction of the schedule.
+/* A cache of the duals of dependence relations, shared by
+ * a dependence graph and all the subgraphs extracted from it.
  *
- * intra_hmap is a cache, mapping dependence relations to their dual,
+ * intra_hmap maps dependence relations to their dual,
  *	for dependences from a node to itself
- * inter_hmap is a cache, mapping dependence relations to their dual,
+ * inter_hmap maps dependence relations to their dual,
  *	for dependences between distinct nodes
  * if compression is involved then the key for these maps
  * is the original, uncompressed dependence relation, while
  * the value is the dual of the compressed dependence relation.
+ * Since the nodes of a subgraph are compressed in the same way
+ * as the corresponding nodes of the original graph,
+ * the cached duals remain valid in the subgraphs.
+ *
+ * ref is the number of graphs that refer to the cache.
+ */
+struct isl_sched_coef_cache {
+	int ref;
+
+	isl_map_to_basic_set *intra_hmap;
+	isl_map_to_basic_set *inter_hmap;
+};
+
+/* Statistics about the (I)LP problems of a given kind
+ * solved during the construction of a schedule.
+ *
+ * "n" is the number of problems that were solved,
+ * "us" the total time (in microseconds) spent solving them and
+ * "pivots" the total number of tableau pivots.
+ * "max_var" and "max_con" are the maximal number of variables and
+ * constraints of any of these problems.
+ */
+struct isl_sched_lp_stats {
+	long n;
+	uint64_t us;
+	long pivots;
+	int max_var;
+	int max_con;
+};
+
+/* Statistics about the most recent construction of a schedule
+ * in a given isl_ctx.
+ *
+ * "total_us" is the total time (in microseconds) spent in
+ *	isl_schedule_constraints_compute_schedule
+ * "graph_init_us" is the time spent constructing the dependence graph
+ * "n_dual" is the number of dependence relations for which
+ *	the dual (the set of valid constraint coefficients) was computed and
+ *	"dual_us" the time spent computing these duals
+ * "n_farkas" is the number of basic relations for which the dual
+ *	was computed using Farkas' lemma and "n_generator" the number
+ *	of those for which it was computed from generators
+ * "band" contains information about the LPs solved for finding
+ *	the rows of a band (including those of tentative merges)
+ * "carry" contains information about the LPs solved for carrying
+ *	dependences
+ * "n_merge_attempt" is the number of times clustering tried to merge
+ *	clusters, "n_merge" the number of successful merges and
+ *	"merge_us" the time spent in these attempts, including the time
+ *	spent solving band LPs and computing duals for them.
+ */
+struct isl_sched_stats {
+	uint64_t total_us;
+	uint64_t graph_init_us;
+	long n_dual;
+	uint64_t dual_us;
+	long n_farkas;
+	long n_generator;
+	struct isl_sched_lp_stats band;
+	struct isl_sched_lp_stats carry;
+	long n_merge_attempt;
+	long n_merge;
+	uint64_t merge_us;
+};
+
+/* Add the statistics in "src" to those in "dst".
+ */
+static void lp_stats_add(struct isl_sched_lp_stats *dst,
+	struct isl_sched_lp_stats *src)
+{
+	dst->n += src->n;
+	dst->us += src->us;
+	dst->pivots += src->pivots;
+	if (src->max_var > dst->max_var)
+		dst->max_var = src->max_var;
+	if (src->max_con > dst->max_con)
+		dst->max_con = src->max_con;
+}
+
+/* Add the statistics in "src" to those in "dst",
+ * except for the total time.
+ */
+static void sched_stats_add(struct isl_sched_stats *dst,
+	struct isl_sched_stats *src)
+{
+	dst->graph_init_us += src->graph_init_us;
+	dst->n_dual += src->n_dual;
+	dst->dual_us += src->dual_us;
+	dst->n_farkas += src->n_farkas;
+	dst->n_generator += src->n_generator;
+	lp_stats_add(&dst->band, &src->band);
+	lp_stats_add(&dst->carry, &src->carry);
+	dst->n_merge_attempt += src->n_merge_attempt;
+	dst->n_merge += src->n_merge;
+	dst->merge_us += src->merge_us;
+}
+
+/* Record in "stats" that an (I)LP problem "lp" has been solved,
+ * where the solution started at time "start" and
+ * the pivot counter of the context was equal to "pivots" at that time.
+ */
+static void lp_stats_record(struct isl_sched_lp_stats *stats,
+	__isl_keep isl_basic_set *lp, uint64_t start, long pivots)
+{
+	isl_ctx *ctx;
+	int n_var, n_con;
+
+	if (!lp)
+		return;
+
+	ctx = isl_basic_set_get_ctx(lp);
+	stats->n++;
+	stats->us += isl_clock_us() - start;
+	stats->pivots += ctx->stats->tab_pivots - pivots;
+	n_var = isl_basic_set_dim(lp, isl_dim_set);
+	n_con = lp->n_eq + lp->n_ineq;
+	if (n_var > stats->max_var)
+		stats->max_var = n_var;
+	if (n_con > stats->max_con)
+		stats->max_con = n_con;
+}
+
+/* Internal information about the dependence graph used during
+ * the construction of the schedule.
+ *
+ * coef_cache caches the duals of the dependence relations and
+ *	is shared with all subgraphs
+ * stats collects statistics about the construction and
+ *	is shared with all subgraphs (except those that are scheduled
+ *	as separate tasks, which collect their own statistics)
  *
  * n is the number of nodes
  * node is the list of nodes
@@ -783,10 +1241,15 @@ static int is_conditional_validity(struct isl_sched_edge *edge)
  *
  * max_weight is used during clustering and represents the maximal
  * weight of the relevant proximity edges.
+ *
+ * deadline is the time (as computed by isl_deadline_from_timeout)
+ *	at which the schedule_budget expires, or zero if there is no budget
+ * degraded is set if the budget has expired and the graph is being
+ *	scheduled using the cheaper fallback algorithm
  */
 struct isl_sched_graph {
-	isl_map_to_basic_set *intra_hmap;
-	isl_map_to_basic_set *inter_hmap;
+	struct isl_sched_coef_cache *coef_cache;
+	struct isl_sched_stats *stats;
 
 	struct isl_sched_node *node;
 	int n;
@@ -818,6 +1281,9 @@ struct isl_sched_graph {
 	int weak;
 
 	int max_weight;
+
+	uint64_t deadline;
+	int degraded;
 };
 
 /* Initialize node_table based on the list of nodes.
@@ -1056,6 +1522,54 @@ static isl_bool graph_has_validity_edge(struct isl_sched_graph *graph,
 	return graph_has_edge(graph, isl_edge_conditional_validity, src, dst);
 }
 
+/* Allocate a new cache of duals of dependence relations for
+ * a graph with "n_edge" edges.
+ */
+static struct isl_sched_coef_cache *coef_cache_alloc(isl_ctx *ctx,
+	int n_edge)
+{
+	struct isl_sched_coef_cache *cache;
+
+	cache = isl_calloc_type(ctx, struct isl_sched_coef_cache);
+	if (!cache)
+		return NULL;
+	cache->ref = 1;
+	cache->intra_hmap = isl_map_to_basic_set_alloc(ctx, 2 * n_edge);
+	cache->inter_hmap = isl_map_to_basic_set_alloc(ctx, 2 * n_edge);
+	if (!cache->intra_hmap || !cache->inter_hmap) {
+		isl_map_to_basic_set_free(cache->intra_hmap);
+		isl_map_to_basic_set_free(cache->inter_hmap);
+		free(cache);
+		return NULL;
+	}
+
+	return cache;
+}
+
+/* Return a new reference to "cache".
+ */
+static struct isl_sched_coef_cache *coef_cache_copy(
+	struct isl_sched_coef_cache *cache)
+{
+	if (!cache)
+		return NULL;
+	cache->ref++;
+	return cache;
+}
+
+/* Drop a reference to "cache", freeing it if it was the last one.
+ */
+static void coef_cache_free(struct isl_sched_coef_cache *cache)
+{
+	if (!cache)
+		return;
+	if (--cache->ref > 0)
+		return;
+	isl_map_to_basic_set_free(cache->intra_hmap);
+	isl_map_to_basic_set_free(cache->inter_hmap);
+	free(cache);
+}
+
 static int graph_alloc(isl_ctx *ctx, struct isl_sched_graph *graph,
 	int n_node, int n_edge)
 {
@@ -1069,9 +1583,6 @@ static int graph_alloc(isl_ctx *ctx, struct isl_sched_graph *graph,
 	graph->edge = isl_calloc_array(ctx,
 					struct isl_sched_edge, graph->n_edge);
 
-	graph->intra_hmap = isl_map_to_basic_set_alloc(ctx, 2 * n_edge);
-	graph->inter_hmap = isl_map_to_basic_set_alloc(ctx, 2 * n_edge);
-
 	if (!graph->node || !graph->region || (graph->n_edge && !graph->edge) ||
 	    !graph->sorted)
 		return -1;
@@ -1082,12 +1593,27 @@ static int graph_alloc(isl_ctx *ctx, struct isl_sched_graph *graph,
 	return 0;
 }
 
+/* Drop the constraints on the coefficients that are kept in "edge"
+ * for use in the next LP problem, along with the objects
+ * from which they were derived.
+ */
+static void edge_clear_lp_coef(struct isl_sched_edge *edge)
+{
+	isl_map_free(edge->lp_map);
+	isl_mat_free(edge->lp_src_cmap);
+	isl_mat_free(edge->lp_dst_cmap);
+	isl_basic_set_free(edge->lp_coef);
+	edge->lp_map = NULL;
+	edge->lp_src_cmap = NULL;
+	edge->lp_dst_cmap = NULL;
+	edge->lp_coef = NULL;
+}
+
 static void graph_free(isl_ctx *ctx, struct isl_sched_graph *graph)
 {
 	int i;
 
-	isl_map_to_basic_set_free(graph->intra_hmap);
-	isl_map_to_basic_set_free(graph->inter_hmap);
+	coef_cache_free(graph->coef_cache);
 
 	if (graph->node)
 		for (i = 0; i < graph->n; ++i) {
@@ -1104,6 +1630,7 @@ static void graph_free(isl_ctx *ctx, struct isl_sched_graph *graph)
 				free(graph->node[i].coincident);
 			isl_multi_val_free(graph->node[i].sizes);
 			isl_vec_free(graph->node[i].max);
+			isl_mat_free(graph->node[i].fixed);
 		}
 	free(graph->node);
 	free(graph->sorted);
@@ -1112,6 +1639,7 @@ static void graph_free(isl_ctx *ctx, struct isl_sched_graph *graph)
 			isl_map_free(graph->edge[i].map);
 			isl_union_map_free(graph->edge[i].tagged_condition);
 			isl_union_map_free(graph->edge[i].tagged_validity);
+			edge_clear_lp_coef(&graph->edge[i]);
 		}
 	free(graph->edge);
 	free(graph->region);
@@ -1725,6 +2253,9 @@ static isl_stat graph_init(struct isl_sched_graph *graph,
 	if (graph_alloc(ctx, graph, graph->n,
 	    isl_schedule_constraints_n_map(sc)) < 0)
 		return isl_stat_error;
+	graph->coef_cache = coef_cache_alloc(ctx, graph->n_edge);
+	if (!graph->coef_cache)
+		return isl_stat_error;
 
 	if (compute_max_row(graph, sc) < 0)
 		return isl_stat_error;
@@ -1755,42 +2286,142 @@ static isl_stat graph_init(struct isl_sched_graph *graph,
 	return isl_stat_ok;
 }
 
-/* Check whether there is any dependence from node[j] to node[i]
- * or from node[i] to node[j].
+/* Does "edge" represent a dependence between its source and sink
+ * that should be taken into account by detect_sccs or
+ * (if "weak" is set) by detect_wccs?
+ *
+ * That is, is "edge" a non-empty edge of any type (if "weak" is set) or
+ * a non-empty (conditional) validity edge (if "weak" is not set)?
+ * As in graph_has_edge, an edge is only taken into account
+ * for a given type if it is the edge of that type
+ * in graph->edge_table.
  */
-static isl_bool node_follows_weak(int i, int j, void *user)
+static isl_bool is_follows_edge(struct isl_sched_graph *graph,
+	struct isl_sched_edge *edge, int weak)
 {
-	isl_bool f;
-	struct isl_sched_graph *graph = user;
+	enum isl_edge_type t;
+
+	for (t = isl_edge_first; t <= isl_edge_last; ++t) {
+		if (!weak && t != isl_edge_validity &&
+		    t != isl_edge_conditional_validity)
+			continue;
+		if (!is_type(edge, t))
+			continue;
+		if (graph_find_edge(graph, t, edge->src, edge->dst) != edge)
+			continue;
+		return isl_bool_not(isl_map_plain_is_empty(edge->map));
+	}
+
+	return isl_bool_false;
+}
+
+static int cmp_int_dec(const void *a, const void *b, void *data)
+{
+	const int *i1 = a;
+	const int *i2 = b;
 
-	f = graph_has_any_edge(graph, &graph->node[j], &graph->node[i]);
-	if (f < 0 || f)
-		return f;
-	return graph_has_any_edge(graph, &graph->node[i], &graph->node[j]);
+	return *i2 - *i1;
 }
 
-/* Check whether there is a (conditional) validity dependence from node[j]
- * to node[i], forcing node[i] to follow node[j].
+/* Construct a compressed sparse row representation of the dependences
+ * between the nodes of "graph" that are taken into account
+ * by detect_sccs or (if "weak" is set) by detect_wccs,
+ * in the form expected by isl_tarjan_graph_init_csr.
+ * In particular, on success, node i of "graph" follows the nodes
+ * (*follows)[(*start)[i]], ..., (*follows)[(*start)[i + 1] - 1].
+ *
+ * If "weak" is set, then node i follows node j if there is any edge
+ * between the two nodes, in either direction.
+ * Otherwise, node i follows node j if there is a (conditional) validity
+ * edge from node j to node i.
+ *
+ * The relevant edges are first marked in "rel".  The number of
+ * nodes followed by each node is then computed in "start",
+ * after which "start" is turned into an array of offsets and
+ * the followed nodes are filled in.  Finally, the nodes followed
+ * by each node are sorted in decreasing order and
+ * any duplicates are removed.
  */
-static isl_bool node_follows_strong(int i, int j, void *user)
+static isl_stat graph_follows_csr(isl_ctx *ctx, struct isl_sched_graph *graph,
+	int weak, int **start, int **follows)
 {
-	struct isl_sched_graph *graph = user;
+	int i, j, k, n;
+	int *rel, *pos, *s, *f;
 
-	return graph_has_validity_edge(graph, &graph->node[j], &graph->node[i]);
+	rel = isl_alloc_array(ctx, int, graph->n_edge);
+	pos = isl_calloc_array(ctx, int, graph->n + 1);
+	s = isl_calloc_array(ctx, int, graph->n + 1);
+	f = isl_alloc_array(ctx, int, 2 * graph->n_edge);
+	if ((graph->n_edge && (!rel || !f)) || !pos || !s)
+		goto error;
+
+	for (i = 0; i < graph->n_edge; ++i) {
+		struct isl_sched_edge *edge = &graph->edge[i];
+		isl_bool r;
+
+		r = is_follows_edge(graph, edge, weak);
+		if (r < 0)
+			goto error;
+		rel[i] = r && edge->src != edge->dst;
+		if (!rel[i])
+			continue;
+		s[edge->dst - graph->node + 1]++;
+		if (weak)
+			s[edge->src - graph->node + 1]++;
+	}
+	for (i = 0; i < graph->n; ++i) {
+		s[i + 1] += s[i];
+		pos[i] = s[i];
+	}
+	for (i = 0; i < graph->n_edge; ++i) {
+		int src, dst;
+
+		if (!rel[i])
+			continue;
+		src = graph->edge[i].src - graph->node;
+		dst = graph->edge[i].dst - graph->node;
+		f[pos[dst]++] = src;
+		if (weak)
+			f[pos[src]++] = dst;
+	}
+
+	n = 0;
+	for (i = 0; i < graph->n; ++i) {
+		int first = n;
+
+		if (isl_sort(f + s[i], s[i + 1] - s[i], sizeof(int),
+				&cmp_int_dec, NULL) < 0)
+			goto error;
+		for (j = s[i]; j < s[i + 1]; ++j) {
+			k = f[j];
+			if (n > first && f[n - 1] == k)
+				continue;
+			f[n++] = k;
+		}
+		s[i] = first;
+	}
+	s[graph->n] = n;
+
+	free(rel);
+	free(pos);
+	*start = s;
+	*follows = f;
+	return isl_stat_ok;
+error:
+	free(rel);
+	free(pos);
+	free(s);
+	free(f);
+	return isl_stat_error;
 }
 
-/* Use Tarjan's algorithm for computing the strongly connected components
- * in the dependence graph only considering those edges defined by "follows".
+/* Set the scc fields of the nodes of "graph" and graph->scc
+ * based on the decomposition "g" computed by Tarjan's algorithm.
  */
-static int detect_ccs(isl_ctx *ctx, struct isl_sched_graph *graph,
-	isl_bool (*follows)(int i, int j, void *user))
+static void graph_set_sccs(struct isl_sched_graph *graph,
+	struct isl_tarjan_graph *g)
 {
 	int i, n;
-	struct isl_tarjan_graph *g = NULL;
-
-	g = isl_tarjan_graph_init(ctx, graph->n, follows, graph);
-	if (!g)
-		return -1;
 
 	graph->scc = 0;
 	i = 0;
@@ -1804,20 +2435,63 @@ static int detect_ccs(isl_ctx *ctx, struct isl_sched_graph *graph,
 		++i;
 		graph->scc++;
 	}
+}
+
+/* Use Tarjan's algorithm for computing the strongly connected components
+ * in the dependence graph only considering those edges defined by "follows".
+ */
+static int detect_ccs(isl_ctx *ctx, struct isl_sched_graph *graph,
+	isl_bool (*follows)(int i, int j, void *user))
+{
+	struct isl_tarjan_graph *g = NULL;
+
+	g = isl_tarjan_graph_init(ctx, graph->n, follows, graph);
+	if (!g)
+		return -1;
 
+	graph_set_sccs(graph, g);
 	isl_tarjan_graph_free(g);
 
 	return 0;
 }
 
-/* Apply Tarjan's algorithm to detect the strongly connected components
- * in the dependence graph.
- * Only consider the (conditional) validity dependences and clear "weak".
+/* Use Tarjan's algorithm for computing the strongly connected components
+ * in the dependence graph, considering all edges if "weak" is set and
+ * only the (conditional) validity edges otherwise, and set graph->weak
+ * accordingly.
+ *
+ * Rather than checking for the presence of an edge between
+ * every pair of nodes, construct an adjacency representation
+ * of the edges first.
  */
-static int detect_sccs(isl_ctx *ctx, struct isl_sched_graph *graph)
+static int detect_ccs_csr(isl_ctx *ctx, struct isl_sched_graph *graph,
+	int weak)
 {
-	graph->weak = 0;
-	return detect_ccs(ctx, graph, &node_follows_strong);
+	int *start, *follows;
+	struct isl_tarjan_graph *g = NULL;
+
+	if (graph_follows_csr(ctx, graph, weak, &start, &follows) < 0)
+		return -1;
+	g = isl_tarjan_graph_init_csr(ctx, graph->n, start, follows);
+	free(start);
+	free(follows);
+	if (!g)
+		return -1;
+
+	graph->weak = weak;
+	graph_set_sccs(graph, g);
+	isl_tarjan_graph_free(g);
+
+	return 0;
+}
+
+/* Apply Tarjan's algorithm to detect the strongly connected components
+ * in the dependence graph.
+ * Only consider the (conditional) validity dependences and clear "weak".
+ */
+static int detect_sccs(isl_ctx *ctx, struct isl_sched_graph *graph)
+{
+	return detect_ccs_csr(ctx, graph, 0);
 }
 
 /* Apply Tarjan's algorithm to detect the (weakly) connected components
@@ -1826,8 +2500,7 @@ static int detect_sccs(isl_ctx *ctx, struct isl_sched_graph *graph)
  */
 static int detect_wccs(isl_ctx *ctx, struct isl_sched_graph *graph)
 {
-	graph->weak = 1;
-	return detect_ccs(ctx, graph, &node_follows_weak);
+	return detect_ccs_csr(ctx, graph, 1);
 }
 
 static int cmp_scc(const void *a, const void *b, void *data)
@@ -1846,6 +2519,64 @@ static int sort_sccs(struct isl_sched_graph *graph)
 	return isl_sort(graph->sorted, graph->n, sizeof(int), &cmp_scc, graph);
 }
 
+/* Construct the set of coefficients of valid constraints for "bset",
+ * either using Farkas' lemma or from the generators of "bset".
+ * The generators are only used if "max" is positive and
+ * if there are guaranteed to be at most "max" of them.
+ * Keep track of which construction was used in graph->stats.
+ */
+static __isl_give isl_basic_set *basic_set_coefficients(
+	struct isl_sched_graph *graph, __isl_take isl_basic_set *bset, int max)
+{
+	int n = 0;
+
+	if (max > 0)
+		n = isl_basic_set_n_generators_bound(bset, max);
+	if (n < 0)
+		return isl_basic_set_free(bset);
+	if (max <= 0 || n > max) {
+		graph->stats->n_farkas++;
+		return isl_basic_set_coefficients(bset);
+	}
+	graph->stats->n_generator++;
+	return isl_basic_set_coefficients_from_generators(bset);
+}
+
+/* Construct the set of coefficients of valid constraints for "set",
+ * as in isl_set_coefficients, but choosing the construction
+ * for each basic set separately.
+ * In particular, if the schedule_max_generators option is set,
+ * then the dual of a basic set with at most that many generators
+ * is constructed from those generators.
+ * Otherwise, Farkas' lemma is applied.
+ */
+static __isl_give isl_basic_set *set_coefficients(
+	struct isl_sched_graph *graph, __isl_take isl_set *set)
+{
+	int i;
+	int max;
+	isl_basic_set *coef;
+
+	if (!set)
+		return NULL;
+	if (set->n == 0)
+		return isl_set_coefficients(set);
+
+	max = set->ctx->opt->schedule_max_generators;
+	coef = basic_set_coefficients(graph,
+				    isl_basic_set_copy(set->p[0]), max);
+	for (i = 1; i < set->n; ++i) {
+		isl_basic_set *coef_i;
+
+		coef_i = basic_set_coefficients(graph,
+					    isl_basic_set_copy(set->p[i]), max);
+		coef = isl_basic_set_intersect(coef, coef_i);
+	}
+
+	isl_set_free(set);
+	return coef;
+}
+
 /* Given a dependence relation R from "node" to itself,
  * construct the set of coefficients of valid constraints for elements
  * in that dependence relation.
@@ -1874,13 +2605,15 @@ static __isl_give isl_basic_set *intra_coefficients(
 	isl_map *key;
 	isl_basic_set *coef;
 	isl_maybe_isl_basic_set m;
+	uint64_t start;
 
-	m = isl_map_to_basic_set_try_get(graph->intra_hmap, map);
+	m = isl_map_to_basic_set_try_get(graph->coef_cache->intra_hmap, map);
 	if (m.valid < 0 || m.valid) {
 		isl_map_free(map);
 		return m.value;
 	}
 
+	start = isl_clock_us();
 	key = isl_map_copy(map);
 	if (node->compressed) {
 		map = isl_map_preimage_domain_multi_aff(map,
@@ -1889,9 +2622,11 @@ static __isl_give isl_basic_set *intra_coefficients(
 				    isl_multi_aff_copy(node->decompress));
 	}
 	delta = isl_set_remove_divs(isl_map_deltas(map));
-	coef = isl_set_coefficients(delta);
-	graph->intra_hmap = isl_map_to_basic_set_set(graph->intra_hmap, key,
-					isl_basic_set_copy(coef));
+	coef = set_coefficients(graph, delta);
+	graph->coef_cache->intra_hmap = isl_map_to_basic_set_set(
+		graph->coef_cache->intra_hmap, key, isl_basic_set_copy(coef));
+	graph->stats->n_dual++;
+	graph->stats->dual_us += isl_clock_us() - start;
 
 	return coef;
 }
@@ -1915,13 +2650,15 @@ static __isl_give isl_basic_set *inter_coefficients(
 	isl_map *key;
 	isl_basic_set *coef;
 	isl_maybe_isl_basic_set m;
+	uint64_t start;
 
-	m = isl_map_to_basic_set_try_get(graph->inter_hmap, map);
+	m = isl_map_to_basic_set_try_get(graph->coef_cache->inter_hmap, map);
 	if (m.valid < 0 || m.valid) {
 		isl_map_free(map);
 		return m.value;
 	}
 
+	start = isl_clock_us();
 	key = isl_map_copy(map);
 	if (edge->src->compressed)
 		map = isl_map_preimage_domain_multi_aff(map,
@@ -1930,9 +2667,11 @@ static __isl_give isl_basic_set *inter_coefficients(
 		map = isl_map_preimage_range_multi_aff(map,
 				    isl_multi_aff_copy(edge->dst->decompress));
 	set = isl_map_wrap(isl_map_remove_divs(map));
-	coef = isl_set_coefficients(set);
-	graph->inter_hmap = isl_map_to_basic_set_set(graph->inter_hmap, key,
-					isl_basic_set_copy(coef));
+	coef = set_coefficients(graph, set);
+	graph->coef_cache->inter_hmap = isl_map_to_basic_set_set(
+		graph->coef_cache->inter_hmap, key, isl_basic_set_copy(coef));
+	graph->stats->n_dual++;
+	graph->stats->dual_us += isl_clock_us() - start;
 
 	return coef;
 }
@@ -1958,6 +2697,56 @@ static int coef_var_offset(__isl_keep isl_basic_set *coef)
 	return offset;
 }
 
+/* Return the constraints on the coefficients of valid affine functions
+ * over the dependence relation of "edge", with the coefficients
+ * of the variables of the source and sink written as linear combinations
+ * of the columns of the cmap of the corresponding node.
+ *
+ * The result only depends on the dependence relation and on the cmaps
+ * and these typically remain unchanged between consecutive calls
+ * to setup_lp, e.g., when the LP problem is constructed again
+ * without coincidence constraints.  The result is therefore kept
+ * in "edge" and reused as long as the dependence relation and
+ * the cmaps are the same objects.
+ */
+static __isl_give isl_basic_set *edge_lp_coefficients(
+	struct isl_sched_graph *graph, struct isl_sched_edge *edge)
+{
+	int offset;
+	isl_map *map;
+	isl_basic_set *coef;
+	struct isl_sched_node *src = edge->src;
+	struct isl_sched_node *dst = edge->dst;
+
+	if (edge->lp_coef && edge->lp_map == edge->map &&
+	    edge->lp_src_cmap == src->cmap && edge->lp_dst_cmap == dst->cmap)
+		return isl_basic_set_copy(edge->lp_coef);
+
+	map = isl_map_copy(edge->map);
+	if (src == dst)
+		coef = intra_coefficients(graph, src, map);
+	else
+		coef = inter_coefficients(graph, edge, map);
+
+	offset = coef_var_offset(coef);
+
+	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
+				offset, isl_mat_copy(src->cmap));
+	if (src != dst)
+		coef = isl_basic_set_transform_dims(coef, isl_dim_set,
+				offset + src->nvar, isl_mat_copy(dst->cmap));
+	if (!coef)
+		return NULL;
+
+	edge_clear_lp_coef(edge);
+	edge->lp_map = isl_map_copy(edge->map);
+	edge->lp_src_cmap = isl_mat_copy(src->cmap);
+	edge->lp_dst_cmap = isl_mat_copy(dst->cmap);
+	edge->lp_coef = isl_basic_set_copy(coef);
+
+	return coef;
+}
+
 /* Return the offset of the coefficients of the variables of "node"
  * within the (I)LP.
  *
@@ -2070,21 +2859,16 @@ static isl_stat add_intra_validity_constraints(struct isl_sched_graph *graph,
 	struct isl_sched_edge *edge)
 {
 	int offset;
-	isl_map *map = isl_map_copy(edge->map);
-	isl_ctx *ctx = isl_map_get_ctx(map);
+	isl_ctx *ctx = isl_map_get_ctx(edge->map);
 	isl_dim_map *dim_map;
 	isl_basic_set *coef;
 	struct isl_sched_node *node = edge->src;
 
-	coef = intra_coefficients(graph, node, map);
-
-	offset = coef_var_offset(coef);
-
-	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
-					    offset, isl_mat_copy(node->cmap));
+	coef = edge_lp_coefficients(graph, edge);
 	if (!coef)
 		return isl_stat_error;
 
+	offset = coef_var_offset(coef);
 	dim_map = intra_dim_map(ctx, graph, node, offset, 1);
 	graph->lp = isl_basic_set_extend_constraints(graph->lp,
 			coef->n_eq, coef->n_ineq);
@@ -2115,24 +2899,17 @@ static isl_stat add_inter_validity_constraints(struct isl_sched_graph *graph,
 	struct isl_sched_edge *edge)
 {
 	int offset;
-	isl_map *map = isl_map_copy(edge->map);
-	isl_ctx *ctx = isl_map_get_ctx(map);
+	isl_ctx *ctx = isl_map_get_ctx(edge->map);
 	isl_dim_map *dim_map;
 	isl_basic_set *coef;
 	struct isl_sched_node *src = edge->src;
 	struct isl_sched_node *dst = edge->dst;
 
-	coef = inter_coefficients(graph, edge, map);
-
-	offset = coef_var_offset(coef);
-
-	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
-				offset, isl_mat_copy(src->cmap));
-	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
-				offset + src->nvar, isl_mat_copy(dst->cmap));
+	coef = edge_lp_coefficients(graph, edge);
 	if (!coef)
 		return isl_stat_error;
 
+	offset = coef_var_offset(coef);
 	dim_map = inter_dim_map(ctx, graph, src, dst, offset, 1);
 
 	edge->start = graph->lp->n_ineq;
@@ -2196,21 +2973,16 @@ static isl_stat add_intra_proximity_constraints(struct isl_sched_graph *graph,
 {
 	int offset;
 	unsigned nparam;
-	isl_map *map = isl_map_copy(edge->map);
-	isl_ctx *ctx = isl_map_get_ctx(map);
+	isl_ctx *ctx = isl_map_get_ctx(edge->map);
 	isl_dim_map *dim_map;
 	isl_basic_set *coef;
 	struct isl_sched_node *node = edge->src;
 
-	coef = intra_coefficients(graph, node, map);
-
-	offset = coef_var_offset(coef);
-
-	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
-					    offset, isl_mat_copy(node->cmap));
+	coef = edge_lp_coefficients(graph, edge);
 	if (!coef)
 		return isl_stat_error;
 
+	offset = coef_var_offset(coef);
 	nparam = isl_space_dim(node->space, isl_dim_param);
 	dim_map = intra_dim_map(ctx, graph, node, offset, -s);
 
@@ -2283,24 +3055,17 @@ static isl_stat add_inter_proximity_constraints(struct isl_sched_graph *graph,
 {
 	int offset;
 	unsigned nparam;
-	isl_map *map = isl_map_copy(edge->map);
-	isl_ctx *ctx = isl_map_get_ctx(map);
+	isl_ctx *ctx = isl_map_get_ctx(edge->map);
 	isl_dim_map *dim_map;
 	isl_basic_set *coef;
 	struct isl_sched_node *src = edge->src;
 	struct isl_sched_node *dst = edge->dst;
 
-	coef = inter_coefficients(graph, edge, map);
-
-	offset = coef_var_offset(coef);
-
-	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
-				offset, isl_mat_copy(src->cmap));
-	coef = isl_basic_set_transform_dims(coef, isl_dim_set,
-				offset + src->nvar, isl_mat_copy(dst->cmap));
+	coef = edge_lp_coefficients(graph, edge);
 	if (!coef)
 		return isl_stat_error;
 
+	offset = coef_var_offset(coef);
 	nparam = isl_space_dim(src->space, isl_dim_param);
 	dim_map = inter_dim_map(ctx, graph, src, dst, offset, -s);
 
@@ -2427,26 +3192,40 @@ static int add_all_proximity_constraints(struct isl_sched_graph *graph,
  * computed basis.
  * Similarly, the matrix U is transposed such that we can
  * compute the coefficients c = U s from a schedule row s.
+ *
+ * If the basis is the same as the current one, then the current
+ * matrices are kept such that the constraints that were derived
+ * from them by edge_lp_coefficients can be reused.
  */
 static int node_update_cmap(struct isl_sched_node *node)
 {
 	isl_mat *H, *U, *Q;
 	int n_row = isl_mat_rows(node->sched);
+	int equal;
 
 	H = isl_mat_sub_alloc(node->sched, 0, n_row,
 			      1 + node->nparam, node->nvar);
 
 	H = isl_mat_left_hermite(H, 0, &U, &Q);
+	node->rank = isl_mat_initial_non_zero_cols(H);
+	isl_mat_free(H);
+
+	equal = node->ctrans && Q ? isl_mat_is_equal(node->ctrans, Q) : 0;
+	if (equal) {
+		isl_mat_free(U);
+		isl_mat_free(Q);
+		return node->rank < 0 ? -1 : 0;
+	}
+
 	isl_mat_free(node->cmap);
 	isl_mat_free(node->cinv);
 	isl_mat_free(node->ctrans);
 	node->ctrans = isl_mat_copy(Q);
 	node->cmap = isl_mat_transpose(Q);
 	node->cinv = isl_mat_transpose(U);
-	node->rank = isl_mat_initial_non_zero_cols(H);
-	isl_mat_free(H);
 
-	if (!node->cmap || !node->cinv || !node->ctrans || node->rank < 0)
+	if (equal < 0 || !node->cmap || !node->cinv || !node->ctrans ||
+	    node->rank < 0)
 		return -1;
 	return 0;
 }
@@ -2528,6 +3307,9 @@ static int count_map_constraints(struct isl_sched_graph *graph,
  * proximity		-> 2 (lower and upper bound)
  * local(+any)		-> 2 (>= 0 and <= 0)
  *
+ * The constraints are obtained from edge_lp_coefficients such that
+ * they are available to the functions that add them to the lp problem.
+ *
  * If "use_coincidence" is set, then we treat coincidence edges as local edges.
  * Otherwise, we ignore them.
  */
@@ -2539,11 +3321,18 @@ static int count_constraints(struct isl_sched_graph *graph,
 	*n_eq = *n_ineq = 0;
 	for (i = 0; i < graph->n_edge; ++i) {
 		struct isl_sched_edge *edge= &graph->edge[i];
-		isl_map *map = isl_map_copy(edge->map);
+		isl_basic_set *coef;
+		int f;
 
-		if (count_map_constraints(graph, edge, map, n_eq, n_ineq,
-					    0, use_coincidence) < 0)
+		f = edge_multiplicity(edge, 0, use_coincidence);
+		if (f == 0)
+			continue;
+		coef = edge_lp_coefficients(graph, edge);
+		if (!coef)
 			return -1;
+		*n_eq += f * coef->n_eq;
+		*n_ineq += f * coef->n_ineq;
+		isl_basic_set_free(coef);
 	}
 
 	return 0;
@@ -2830,6 +3619,117 @@ static isl_stat add_var_sum_constraint(struct isl_sched_graph *graph,
 	return isl_stat_ok;
 }
 
+/* Is the next row of "node" fixed by a previous schedule?
+ * That is, is the next row part of the outermost band and
+ * is there a corresponding row in node->fixed?
+ */
+static int node_has_fixed_row(struct isl_sched_graph *graph,
+	struct isl_sched_node *node)
+{
+	if (!node->fixed || graph->band_start != 0)
+		return 0;
+	return graph->n_total_row < isl_mat_rows(node->fixed);
+}
+
+/* Count the number of equality constraints that
+ * add_fixed_row_constraints will add to graph->lp.
+ */
+static int count_fixed_row_constraints(struct isl_sched_graph *graph)
+{
+	int i;
+	int n_eq = 0;
+
+	for (i = 0; i < graph->n; ++i) {
+		struct isl_sched_node *node = &graph->node[i];
+
+		if (node_has_fixed_row(graph, node))
+			n_eq += 1 + node->nparam + node->nvar;
+	}
+
+	return n_eq;
+}
+
+/* Add equality constraints to graph->lp that force the next row
+ * of each node with a fixed next row to be equal to that fixed row.
+ * The constant term and the parameter coefficients are fixed directly,
+ * while the coefficients of the variables are first expressed
+ * in terms of the basis node->cmap used in the LP, i.e.,
+ * t_i_x = U c_i_x with U equal to node->cinv.
+ * The negative part of each t_i_x appears before the positive part.
+ */
+static isl_stat add_fixed_row_constraints(struct isl_sched_graph *graph)
+{
+	int i, j, k;
+	int total;
+
+	total = isl_basic_set_dim(graph->lp, isl_dim_set);
+	for (i = 0; i < graph->n; ++i) {
+		struct isl_sched_node *node = &graph->node[i];
+		int row = graph->n_total_row;
+		int pos;
+		isl_vec *t;
+
+		if (!node_has_fixed_row(graph, node))
+			continue;
+		for (j = 0; j < 1 + node->nparam; ++j) {
+			k = isl_basic_set_alloc_equality(graph->lp);
+			if (k < 0)
+				return isl_stat_error;
+			isl_seq_clr(graph->lp->eq[k], 1 + total);
+			isl_int_neg(graph->lp->eq[k][0],
+				    node->fixed->row[row][j]);
+			isl_int_set_si(graph->lp->eq[k][1 + node->start + j], 1);
+		}
+		t = isl_vec_alloc(isl_mat_get_ctx(node->fixed), node->nvar);
+		if (!t)
+			return isl_stat_error;
+		isl_seq_cpy(t->el, node->fixed->row[row] + 1 + node->nparam,
+			    node->nvar);
+		t = isl_mat_vec_product(isl_mat_copy(node->cinv), t);
+		if (!t)
+			return isl_stat_error;
+		pos = 1 + node_var_coef_offset(node);
+		for (j = 0; j < node->nvar; ++j) {
+			k = isl_basic_set_alloc_equality(graph->lp);
+			if (k < 0) {
+				isl_vec_free(t);
+				return isl_stat_error;
+			}
+			isl_seq_clr(graph->lp->eq[k], 1 + total);
+			isl_int_neg(graph->lp->eq[k][0], t->el[j]);
+			isl_int_set_si(graph->lp->eq[k][pos + 2 * j], -1);
+			isl_int_set_si(graph->lp->eq[k][pos + 2 * j + 1], 1);
+		}
+		isl_vec_free(t);
+	}
+
+	return isl_stat_ok;
+}
+
+/* Drop the rows imposed by a previous schedule from all nodes of "graph".
+ */
+static void drop_fixed_rows(struct isl_sched_graph *graph)
+{
+	int i;
+
+	for (i = 0; i < graph->n; ++i)
+		graph->node[i].fixed = isl_mat_free(graph->node[i].fixed);
+}
+
+/* Does any node of "graph" have a next row that is fixed
+ * by a previous schedule?
+ */
+static int has_fixed_row(struct isl_sched_graph *graph)
+{
+	int i;
+
+	for (i = 0; i < graph->n; ++i)
+		if (node_has_fixed_row(graph, &graph->node[i]))
+			return 1;
+
+	return 0;
+}
+
 /* Construct an ILP problem for finding schedule coefficients
  * that result in non-negative, but small dependence distances
  * over all dependences.
@@ -2859,7 +3759,8 @@ static isl_stat add_var_sum_constraint(struct isl_sched_graph *graph,
  * such that c_i_x = Q t_i_x with Q equal to node->cmap.
  *
  * The constraints are those from the edges plus two or three equalities
- * to express the sums.
+ * to express the sums, as well as equalities that fix the next row
+ * of nodes for which this row is imposed by a previous schedule.
  *
  * If "use_coincidence" is set, then we treat coincidence edges as local edges.
  * Otherwise, we ignore them.
@@ -2897,6 +3798,7 @@ static isl_stat setup_lp(isl_ctx *ctx, struct isl_sched_graph *graph,
 	space = isl_space_set_alloc(ctx, 0, total);
 	isl_basic_set_free(graph->lp);
 	n_eq += 2 + parametric;
+	n_eq += count_fixed_row_constraints(graph);
 
 	graph->lp = isl_basic_set_alloc_space(space, 0, n_eq, n_ineq);
 
@@ -2914,6 +3816,8 @@ static isl_stat setup_lp(isl_ctx *ctx, struct isl_sched_graph *graph,
 		return isl_stat_error;
 	if (add_all_proximity_constraints(graph, use_coincidence) < 0)
 		return isl_stat_error;
+	if (add_fixed_row_constraints(graph) < 0)
+		return isl_stat_error;
 
 	return isl_stat_ok;
 }
@@ -2977,12 +3881,16 @@ static int needs_row(struct isl_sched_graph *graph, struct isl_sched_node *node)
  * one of the remaining components of t_i_x is non-zero, i.e.,
  * that the new schedule row depends on at least one of the remaining
  * columns of Q.
+ * The effort spent solving the ILP problem is recorded in graph->stats.
  */
 static __isl_give isl_vec *solve_lp(struct isl_sched_graph *graph)
 {
 	int i;
+	isl_ctx *ctx;
 	isl_vec *sol;
 	isl_basic_set *lp;
+	uint64_t start;
+	long pivots;
 
 	for (i = 0; i < graph->n; ++i) {
 		struct isl_sched_node *node = &graph->node[i];
@@ -2993,12 +3901,60 @@ static __isl_give isl_vec *solve_lp(struct isl_sched_graph *graph)
 		else
 			graph->region[i].len = 0;
 	}
+	ctx = isl_basic_set_get_ctx(graph->lp);
+	start = isl_clock_us();
+	pivots = ctx->stats->tab_pivots;
 	lp = isl_basic_set_copy(graph->lp);
 	sol = isl_tab_basic_set_non_trivial_lexmin(lp, 2, graph->n,
 				       graph->region, &check_conflict, graph);
+	lp_stats_record(&graph->stats->band, graph->lp, start, pivots);
 	return sol;
 }
 
+/* Has the time budget for scheduling "graph" expired?
+ * Once the scheduler has switched to the fallback algorithm,
+ * the budget is no longer checked.
+ */
+static int budget_expired(struct isl_sched_graph *graph)
+{
+	return !graph->degraded && isl_deadline_passed(graph->deadline);
+}
+
+/* Solve the ILP problem constructed in setup_lp, aborting
+ * the computation if the time budget of "graph" expires in the meantime.
+ * The budget is enforced by temporarily replacing the deadline of "ctx"
+ * by the deadline of the budget if the latter comes first.
+ * If the computation is aborted because of the budget
+ * (rather than because of the user or the original deadline of "ctx"),
+ * then the error is cleared, *expired is set and NULL is returned.
+ * Any conflict detected during the aborted computation is discarded.
+ */
+static __isl_give isl_vec *solve_lp_within_budget(isl_ctx *ctx,
+	struct isl_sched_graph *graph, int *expired)
+{
+	isl_vec *sol;
+	uint64_t deadline = ctx->deadline;
+
+	*expired = 0;
+	if (!graph->degraded && graph->deadline &&
+	    (!deadline || graph->deadline < deadline))
+		ctx->deadline = graph->deadline;
+	sol = solve_lp(graph);
+	ctx->deadline = deadline;
+
+	if (sol || isl_ctx_last_error(ctx) != isl_error_abort)
+		return sol;
+	if (isl_ctx_aborted(ctx) || isl_deadline_passed(deadline) ||
+	    !budget_expired(graph))
+		return NULL;
+
+	isl_ctx_reset_error(ctx);
+	graph->src_scc = -1;
+	graph->dst_scc = -1;
+	*expired = 1;
+	return NULL;
+}
+
 /* Extract the coefficients for the variables of "node" from "sol".
  *
  * Within each node, the coefficients have the following order:
@@ -3530,9 +4486,12 @@ static __isl_give isl_union_set_list *extract_split(isl_ctx *ctx,
 
 /* Copy nodes that satisfy node_pred from the src dependence graph
  * to the dst dependence graph.
+ * Keep track of the position in "dst" of each node of "src" in "pos",
+ * with -1 representing a node that is not copied.
  */
 static int copy_nodes(struct isl_sched_graph *dst, struct isl_sched_graph *src,
-	int (*node_pred)(struct isl_sched_node *node, int data), int data)
+	int (*node_pred)(struct isl_sched_node *node, int data), int data,
+	int *pos)
 {
 	int i;
 
@@ -3540,10 +4499,12 @@ static int copy_nodes(struct isl_sched_graph *dst, struct isl_sched_graph *src,
 	for (i = 0; i < src->n; ++i) {
 		int j;
 
+		pos[i] = -1;
 		if (!node_pred(&src->node[i], data))
 			continue;
 
 		j = dst->n;
+		pos[i] = j;
 		dst->node[j].space = isl_space_copy(src->node[i].space);
 		dst->node[j].compressed = src->node[i].compressed;
 		dst->node[j].hull = isl_set_copy(src->node[i].hull);
@@ -3558,6 +4519,7 @@ static int copy_nodes(struct isl_sched_graph *dst, struct isl_sched_graph *src,
 		dst->node[j].coincident = src->node[i].coincident;
 		dst->node[j].sizes = isl_multi_val_copy(src->node[i].sizes);
 		dst->node[j].max = isl_vec_copy(src->node[i].max);
+		dst->node[j].fixed = isl_mat_copy(src->node[i].fixed);
 		dst->n++;
 
 		if (!dst->node[j].space || !dst->node[j].sched)
@@ -3573,13 +4535,16 @@ static int copy_nodes(struct isl_sched_graph *dst, struct isl_sched_graph *src,
 
 /* Copy non-empty edges that satisfy edge_pred from the src dependence graph
  * to the dst dependence graph.
+ * "pos" contains the position in "dst" of each node of "src", as computed
+ * by copy_nodes.
  * If the source or destination node of the edge is not in the destination
  * graph, then it must be a backward proximity edge and it should simply
  * be ignored.
  */
 static int copy_edges(isl_ctx *ctx, struct isl_sched_graph *dst,
 	struct isl_sched_graph *src,
-	int (*edge_pred)(struct isl_sched_edge *edge, int data), int data)
+	int (*edge_pred)(struct isl_sched_edge *edge, int data), int data,
+	int *pos)
 {
 	int i;
 	enum isl_edge_type t;
@@ -3591,6 +4556,7 @@ static int copy_edges(isl_ctx *ctx, struct isl_sched_graph *dst,
 		isl_union_map *tagged_condition;
 		isl_union_map *tagged_validity;
 		struct isl_sched_node *dst_src, *dst_dst;
+		int src_pos, dst_pos;
 
 		if (!edge_pred(edge, data))
 			continue;
@@ -3598,9 +4564,9 @@ static int copy_edges(isl_ctx *ctx, struct isl_sched_graph *dst,
 		if (isl_map_plain_is_empty(edge->map))
 			continue;
 
-		dst_src = graph_find_node(ctx, dst, edge->src->space);
-		dst_dst = graph_find_node(ctx, dst, edge->dst->space);
-		if (!dst_src || !dst_dst) {
+		src_pos = pos[edge->src - src->node];
+		dst_pos = pos[edge->dst - src->node];
+		if (src_pos < 0 || dst_pos < 0) {
 			if (is_validity(edge) || is_conditional_validity(edge))
 				isl_die(ctx, isl_error_internal,
 					"backward (conditional) validity edge",
@@ -3608,6 +4574,9 @@ static int copy_edges(isl_ctx *ctx, struct isl_sched_graph *dst,
 			continue;
 		}
 
+		dst_src = &dst->node[src_pos];
+		dst_dst = &dst->node[dst_pos];
+
 		map = isl_map_copy(edge->map);
 		tagged_condition = isl_union_map_copy(edge->tagged_condition);
 		tagged_validity = isl_union_map_copy(edge->tagged_validity);
@@ -3626,6 +4595,8 @@ static int copy_edges(isl_ctx *ctx, struct isl_sched_graph *dst,
 			return -1;
 
 		for (t = isl_edge_first; t <= isl_edge_last; ++t) {
+			if (!is_type(edge, t))
+				continue;
 			if (edge !=
 			    graph_find_edge(src, t, edge->src, edge->dst))
 				continue;
@@ -3667,6 +4638,13 @@ static int compute_maxvar(struct isl_sched_graph *graph)
 /* Extract the subgraph of "graph" that consists of the node satisfying
  * "node_pred" and the edges satisfying "edge_pred" and store
  * the result in "sub".
+ * The subgraph shares the cache of duals of dependence relations
+ * with "graph", such that these duals do not need to be recomputed
+ * for the subgraph.  It also shares the statistics of "graph".
+ *
+ * The edge tables of the subgraph are sized according to the number
+ * of edges of each type in the subgraph rather than in "graph",
+ * since the subgraph may be much smaller than "graph".
  */
 static int extract_sub_graph(isl_ctx *ctx, struct isl_sched_graph *graph,
 	int (*node_pred)(struct isl_sched_node *node, int data),
@@ -3675,33 +4653,175 @@ static int extract_sub_graph(isl_ctx *ctx, struct isl_sched_graph *graph,
 {
 	int i, n = 0, n_edge = 0;
 	int t;
+	int *pos;
 
+	for (t = 0; t <= isl_edge_last; ++t)
+		sub->max_edge[t] = 0;
 	for (i = 0; i < graph->n; ++i)
 		if (node_pred(&graph->node[i], data))
 			++n;
-	for (i = 0; i < graph->n_edge; ++i)
-		if (edge_pred(&graph->edge[i], data))
-			++n_edge;
+	for (i = 0; i < graph->n_edge; ++i) {
+		if (!edge_pred(&graph->edge[i], data))
+			continue;
+		++n_edge;
+		for (t = 0; t <= isl_edge_last; ++t)
+			if (is_type(&graph->edge[i], t))
+				sub->max_edge[t]++;
+	}
 	if (graph_alloc(ctx, sub, n, n_edge) < 0)
 		return -1;
-	if (copy_nodes(sub, graph, node_pred, data) < 0)
-		return -1;
-	if (graph_init_table(ctx, sub) < 0)
-		return -1;
-	for (t = 0; t <= isl_edge_last; ++t)
-		sub->max_edge[t] = graph->max_edge[t];
-	if (graph_init_edge_tables(ctx, sub) < 0)
+	sub->coef_cache = coef_cache_copy(graph->coef_cache);
+	pos = isl_alloc_array(ctx, int, graph->n);
+	if (graph->n && !pos)
 		return -1;
-	if (copy_edges(ctx, sub, graph, edge_pred, data) < 0)
+	if (copy_nodes(sub, graph, node_pred, data, pos) < 0 ||
+	    graph_init_table(ctx, sub) < 0 ||
+	    graph_init_edge_tables(ctx, sub) < 0 ||
+	    copy_edges(ctx, sub, graph, edge_pred, data, pos) < 0) {
+		free(pos);
 		return -1;
+	}
+	free(pos);
 	sub->n_row = graph->n_row;
 	sub->max_row = graph->max_row;
 	sub->n_total_row = graph->n_total_row;
 	sub->band_start = graph->band_start;
+	sub->deadline = graph->deadline;
+	sub->degraded = graph->degraded;
+	sub->stats = graph->stats;
 
 	return 0;
 }
 
+/* Copy the node "src" to "dst", transferring it to "ctx".
+ * Only the fields set by copy_nodes are copied.
+ * The coincident array is shared with "src", as in copy_nodes.
+ *
+ * The components of "src" without an atomic reference count
+ * are only read, apart from the top-level reference count of
+ * the compression maps and the sizes, which are only accessed
+ * by the caller.
+ */
+static isl_stat node_transfer(isl_ctx *ctx, struct isl_sched_node *dst,
+	struct isl_sched_node *src)
+{
+	dst->space = isl_space_transfer(isl_space_copy(src->space), ctx);
+	dst->compressed = src->compressed;
+	dst->hull = isl_set_transfer(isl_set_copy(src->hull), ctx);
+	dst->compress = isl_multi_aff_transfer(
+				isl_multi_aff_copy(src->compress), ctx);
+	dst->decompress = isl_multi_aff_transfer(
+				isl_multi_aff_copy(src->decompress), ctx);
+	dst->nvar = src->nvar;
+	dst->nparam = src->nparam;
+	dst->sched = isl_mat_dup_to_ctx(src->sched, ctx);
+	dst->sched_map = isl_map_transfer(isl_map_copy(src->sched_map), ctx);
+	dst->coincident = src->coincident;
+	dst->sizes = isl_multi_val_transfer(isl_multi_val_copy(src->sizes),
+						ctx);
+	dst->max = isl_vec_dup_to_ctx(src->max, ctx);
+	dst->fixed = isl_mat_dup_to_ctx(src->fixed, ctx);
+
+	if (!dst->space || !dst->sched)
+		return isl_stat_error;
+	if (src->sched_map && !dst->sched_map)
+		return isl_stat_error;
+	if (src->sizes && !dst->sizes)
+		return isl_stat_error;
+	if (src->max && !dst->max)
+		return isl_stat_error;
+	if (src->fixed && !dst->fixed)
+		return isl_stat_error;
+	if (dst->compressed &&
+	    (!dst->hull || !dst->compress || !dst->decompress))
+		return isl_stat_error;
+
+	return isl_stat_ok;
+}
+
+/* Copy the edge "edge" of "src" to the edge "dst_edge" of "dst",
+ * transferring it to "ctx" and adding it to the edge tables of "dst".
+ * The nodes of "dst" appear in the same order as those of "src".
+ */
+static isl_stat edge_transfer(isl_ctx *ctx, struct isl_sched_graph *dst,
+	struct isl_sched_edge *dst_edge, struct isl_sched_graph *src,
+	struct isl_sched_edge *edge)
+{
+	enum isl_edge_type t;
+
+	dst_edge->src = &dst->node[edge->src - src->node];
+	dst_edge->dst = &dst->node[edge->dst - src->node];
+	dst_edge->map = isl_map_transfer(isl_map_copy(edge->map), ctx);
+	dst_edge->tagged_condition = isl_union_map_transfer(
+			isl_union_map_copy(edge->tagged_condition), ctx);
+	dst_edge->tagged_validity = isl_union_map_transfer(
+			isl_union_map_copy(edge->tagged_validity), ctx);
+	dst_edge->types = edge->types;
+
+	if (!dst_edge->map)
+		return isl_stat_error;
+	if (edge->tagged_condition && !dst_edge->tagged_condition)
+		return isl_stat_error;
+	if (edge->tagged_validity && !dst_edge->tagged_validity)
+		return isl_stat_error;
+
+	for (t = isl_edge_first; t <= isl_edge_last; ++t) {
+		if (edge != graph_find_edge(src, t, edge->src, edge->dst))
+			continue;
+		if (graph_edge_table_add(ctx, dst, t, dst_edge) < 0)
+			return isl_stat_error;
+	}
+
+	return isl_stat_ok;
+}
+
+/* Construct a copy "dst" of the subgraph "src", constructed
+ * by extract_sub_graph, that lives in "ctx".
+ * "dst" gets a cache of duals of its own, since the cache of "src"
+ * lives in the context of "src".
+ *
+ * This function may be called from a task running in "ctx",
+ * while other tasks are copying other subgraphs of the same graph.
+ * Since the subgraphs have disjoint sets of nodes and edges,
+ * the only objects that may be shared between them are
+ * the spaces and the relations that are not compressed,
+ * which have atomic reference counts in this case.
+ */
+static isl_stat graph_transfer(isl_ctx *ctx, struct isl_sched_graph *dst,
+	struct isl_sched_graph *src)
+{
+	int i;
+	enum isl_edge_type t;
+
+	if (graph_alloc(ctx, dst, src->n, src->n_edge) < 0)
+		return isl_stat_error;
+	dst->coef_cache = coef_cache_alloc(ctx, src->n_edge);
+	if (!dst->coef_cache)
+		return isl_stat_error;
+	for (i = 0; i < src->n; ++i)
+		if (node_transfer(ctx, &dst->node[i], &src->node[i]) < 0)
+			return isl_stat_error;
+	if (graph_init_table(ctx, dst) < 0)
+		return isl_stat_error;
+	for (t = 0; t <= isl_edge_last; ++t)
+		dst->max_edge[t] = src->max_edge[t];
+	if (graph_init_edge_tables(ctx, dst) < 0)
+		return isl_stat_error;
+	for (i = 0; i < src->n_edge; ++i)
+		if (edge_transfer(ctx, dst, &dst->edge[i],
+				    src, &src->edge[i]) < 0)
+			return isl_stat_error;
+	dst->n_row = src->n_row;
+	dst->max_row = src->max_row;
+	dst->n_total_row = src->n_total_row;
+	dst->band_start = src->band_start;
+	dst->maxvar = src->maxvar;
+	dst->deadline = src->deadline;
+	dst->degraded = src->degraded;
+
+	return isl_stat_ok;
+}
+
 static __isl_give isl_schedule_node *compute_schedule(isl_schedule_node *node,
 	struct isl_sched_graph *graph);
 static __isl_give isl_schedule_node *compute_schedule_wcc(
@@ -4570,6 +5690,8 @@ error:
  * of the schedule tree and continue with the construction of the schedule.
  * This insertion and the continued construction is performed by split_scaled
  * after optionally checking for non-trivial common divisors.
+ *
+ * The effort spent solving the LP problem is recorded in graph->stats.
  */
 static __isl_give isl_schedule_node *carry_dependences(
 	__isl_take isl_schedule_node *node, struct isl_sched_graph *graph)
@@ -4580,6 +5702,8 @@ static __isl_give isl_schedule_node *carry_dependences(
 	isl_ctx *ctx;
 	isl_vec *sol;
 	isl_basic_set *lp;
+	uint64_t start;
+	long pivots;
 
 	if (!node)
 		return NULL;
@@ -4592,8 +5716,11 @@ static __isl_give isl_schedule_node *carry_dependences(
 	if (setup_carry_lp(ctx, graph) < 0)
 		return isl_schedule_node_free(node);
 
+	start = isl_clock_us();
+	pivots = ctx->stats->tab_pivots;
 	lp = isl_basic_set_copy(graph->lp);
 	sol = non_neg_lexmin(graph, lp, n_edge);
+	lp_stats_record(&graph->stats->carry, graph->lp, start, pivots);
 	if (!sol)
 		return isl_schedule_node_free(node);
 
@@ -4688,17 +5815,41 @@ static int has_validity_edges(struct isl_sched_graph *graph)
 }
 
 /* Should we apply a Feautrier step?
- * That is, did the user request the Feautrier algorithm and are
+ * That is, did the user request the Feautrier algorithm or
+ * has the time budget expired and are
  * there any validity dependences (left)?
  */
 static int need_feautrier_step(isl_ctx *ctx, struct isl_sched_graph *graph)
 {
-	if (ctx->opt->schedule_algorithm != ISL_SCHEDULE_ALGORITHM_FEAUTRIER)
+	if (ctx->opt->schedule_algorithm != ISL_SCHEDULE_ALGORITHM_FEAUTRIER &&
+	    !graph->degraded)
 		return 0;
 
 	return has_validity_edges(graph);
 }
 
+/* Switch to scheduling "graph" using the fallback algorithm
+ * because the time budget has expired.
+ * Insert a mark node with identifier "degraded" at "node"
+ * to indicate that the subtree was constructed in this way and
+ * return a pointer to the child of the mark node.
+ */
+static __isl_give isl_schedule_node *start_degraded(
+	__isl_take isl_schedule_node *node, struct isl_sched_graph *graph)
+{
+	isl_id *id;
+
+	if (!node)
+		return NULL;
+
+	graph->degraded = 1;
+	id = isl_id_alloc(isl_schedule_node_get_ctx(node), "degraded", NULL);
+	node = isl_schedule_node_insert_mark(node, id);
+	node = isl_schedule_node_child(node, 0);
+
+	return node;
+}
+
 /* Compute a schedule for a connected dependence graph using Feautrier's
  * multi-dimensional scheduling algorithm and return the updated schedule node.
  *
@@ -4928,6 +6079,8 @@ error:
  *	band
  * In each case, we first insert a band node in the schedule tree
  * if any rows have been computed.
+ * If the time budget has expired in the last case, then the remaining
+ * part of the schedule is computed using the fallback algorithm.
  *
  * If the caller managed to complete the schedule, we insert a band node
  * (if any schedule rows were computed) and we finish off by topologically
@@ -4955,6 +6108,11 @@ static __isl_give isl_schedule_node *compute_schedule_finish_band(
 			return compute_next_band(node, graph, 1);
 		if (!initialized && compute_maxvar(graph) < 0)
 			return isl_schedule_node_free(node);
+		if (budget_expired(graph)) {
+			node = start_degraded(node, graph);
+			node = carry_dependences(node, graph);
+			return isl_schedule_node_parent(node);
+		}
 		return carry_dependences(node, graph);
 	}
 
@@ -5001,6 +6159,16 @@ static __isl_give isl_schedule_node *compute_schedule_finish_band(
  * until we are no longer able to compute a schedule.
  * Since there are only a finite number of dependences,
  * there will only be a finite number of iterations.
+ *
+ * If some rows of the outermost band are imposed by a previous schedule
+ * and no valid row can be found that satisfies these constraints,
+ * then the rows of the previous schedule are discarded and
+ * the computation continues without them.
+ *
+ * If the time budget expires, then the computation stops
+ * with the rows that have been found so far.
+ * The caller then falls back to a cheaper algorithm
+ * for the remaining rows.
  */
 static isl_stat compute_schedule_wcc_band(isl_ctx *ctx,
 	struct isl_sched_graph *graph)
@@ -5025,13 +6193,21 @@ static isl_stat compute_schedule_wcc_band(isl_ctx *ctx,
 		isl_vec *sol;
 		int violated;
 		int coincident;
+		int expired;
 
-		graph->src_scc = -1;
+		if (isl_ctx_check_interrupt(ctx) < 0)
+			return isl_stat_error;
+
+		graph->src_scc = -1;
 		graph->dst_scc = -1;
 
+		if (budget_expired(graph))
+			break;
 		if (setup_lp(ctx, graph, use_coincidence) < 0)
 			return isl_stat_error;
-		sol = solve_lp(graph);
+		sol = solve_lp_within_budget(ctx, graph, &expired);
+		if (expired)
+			break;
 		if (!sol)
 			return isl_stat_error;
 		if (sol->size == 0) {
@@ -5042,6 +6218,11 @@ static isl_stat compute_schedule_wcc_band(isl_ctx *ctx,
 				use_coincidence = 0;
 				continue;
 			}
+			if (has_fixed_row(graph)) {
+				drop_fixed_rows(graph);
+				use_coincidence = has_coincidence;
+				continue;
+			}
 			return isl_stat_ok;
 		}
 		coincident = !has_coincidence || use_coincidence;
@@ -5086,6 +6267,14 @@ static __isl_give isl_schedule_node *compute_schedule_wcc_whole(
 	return compute_schedule_finish_band(node, graph, 1);
 }
 
+/* A merge graph that has been constructed and scheduled ahead of time
+ * for merging the clusters of the SCCs marked in "scc_in_merge".
+ */
+struct isl_sched_merge_spec {
+	int *scc_in_merge;
+	struct isl_sched_graph graph;
+};
+
 /* Clustering information used by compute_schedule_wcc_clustering.
  *
  * "n" is the number of SCCs in the original dependence graph
@@ -5106,6 +6295,16 @@ static __isl_give isl_schedule_node *compute_schedule_wcc_whole(
  * "scc_node" is a temporary data structure used inside copy_partial.
  * For each SCC, it keeps track of the number of nodes in the SCC
  * that have already been copied.
+ *
+ * "merge_cache" is the cache of dependence duals shared by
+ * the merge graphs constructed by try_merge.
+ * It is only valid as long as the clusters do not change and
+ * is therefore discarded after every successful merge.
+ *
+ * "spec" contains "n_spec" merge graphs that have been constructed
+ * and scheduled ahead of time by speculate_merges.
+ * Like "merge_cache", they are only valid as long as the clusters
+ * do not change.
  */
 struct isl_clustering {
 	int n;
@@ -5114,6 +6313,9 @@ struct isl_clustering {
 	int *scc_cluster;
 	int *scc_node;
 	int *scc_in_merge;
+	struct isl_sched_coef_cache *merge_cache;
+	int n_spec;
+	struct isl_sched_merge_spec *spec;
 };
 
 /* Initialize the clustering data structure "c" from "graph".
@@ -5135,6 +6337,9 @@ static isl_stat clustering_init(isl_ctx *ctx, struct isl_clustering *c,
 	c->scc_cluster = isl_calloc_array(ctx, int, c->n);
 	c->scc_node = isl_calloc_array(ctx, int, c->n);
 	c->scc_in_merge = isl_calloc_array(ctx, int, c->n);
+	c->merge_cache = NULL;
+	c->n_spec = 0;
+	c->spec = NULL;
 	if (!c->scc || !c->cluster ||
 	    !c->scc_cluster || !c->scc_node || !c->scc_in_merge)
 		return isl_stat_error;
@@ -5154,6 +6359,22 @@ static isl_stat clustering_init(isl_ctx *ctx, struct isl_clustering *c,
 	return isl_stat_ok;
 }
 
+/* Discard the merge graphs that have been constructed ahead of time
+ * in "c".
+ */
+static void clear_speculated_merges(isl_ctx *ctx, struct isl_clustering *c)
+{
+	int i;
+
+	for (i = 0; i < c->n_spec; ++i) {
+		free(c->spec[i].scc_in_merge);
+		graph_free(ctx, &c->spec[i].graph);
+	}
+	free(c->spec);
+	c->spec = NULL;
+	c->n_spec = 0;
+}
+
 /* Free all memory allocated for "c".
  */
 static void clustering_free(isl_ctx *ctx, struct isl_clustering *c)
@@ -5171,6 +6392,8 @@ static void clustering_free(isl_ctx *ctx, struct isl_clustering *c)
 	free(c->scc_cluster);
 	free(c->scc_node);
 	free(c->scc_in_merge);
+	coef_cache_free(c->merge_cache);
+	clear_speculated_merges(ctx, c);
 }
 
 /* Should we refrain from merging the cluster in "graph" with
@@ -5584,6 +6807,8 @@ static __isl_give isl_schedule_constraints *collect_constraints(
  * by transforming the edges in "graph" to the domain.
  * Then initialize a dependence graph for scheduling from these
  * constraints.
+ * The merge graph is subject to the same time budget as "graph" and
+ * shares its statistics.
  */
 static isl_stat init_merge_graph(isl_ctx *ctx, struct isl_sched_graph *graph,
 	struct isl_clustering *c, struct isl_sched_graph *merge_graph)
@@ -5602,6 +6827,8 @@ static isl_stat init_merge_graph(isl_ctx *ctx, struct isl_sched_graph *graph,
 	isl_union_map_free(cluster_map);
 
 	r = graph_init(merge_graph, sc);
+	merge_graph->deadline = graph->deadline;
+	merge_graph->stats = graph->stats;
 
 	isl_schedule_constraints_free(sc);
 
@@ -6164,15 +7391,30 @@ static isl_stat merge(isl_ctx *ctx, struct isl_clustering *c,
 	return isl_stat_ok;
 }
 
-/* Try and merge the clusters of SCCs marked in c->scc_in_merge
- * by scheduling the current cluster bands with respect to each other.
+/* Let "merge_graph" use the cache of dependence duals shared
+ * by all merge graphs of "c", setting it up first if needed.
+ * The merge graph is constructed from the current clusters,
+ * so the duals computed for one merge graph remain valid
+ * for later merge graphs, until the clusters are changed by a merge.
+ */
+static void share_merge_cache(struct isl_clustering *c,
+	struct isl_sched_graph *merge_graph)
+{
+	if (!c->merge_cache) {
+		c->merge_cache = coef_cache_copy(merge_graph->coef_cache);
+		return;
+	}
+	coef_cache_free(merge_graph->coef_cache);
+	merge_graph->coef_cache = coef_cache_copy(c->merge_cache);
+}
+
+/* Construct a dependence graph for scheduling the clusters of SCCs
+ * marked in c->scc_in_merge with respect to each other and
+ * store the result in "merge_graph".
  *
- * Construct a dependence graph with a space for each cluster and
- * with the coordinates of each space corresponding to the schedule
+ * The graph has a space for each cluster, with
+ * the coordinates of each space corresponding to the schedule
  * dimensions of the current band of that cluster.
- * Construct a cluster schedule in this cluster dependence graph and
- * apply it to the current cluster bands if it is applicable
- * according to ok_to_merge.
  *
  * If the number of remaining schedule dimensions in a cluster
  * with a non-maximal current schedule dimension is greater than
@@ -6180,7 +7422,267 @@ static isl_stat merge(isl_ctx *ctx, struct isl_clustering *c,
  * with a maximal current schedule dimension, then restrict
  * the number of rows to be computed in the cluster schedule
  * to the minimal such non-maximal current schedule dimension.
- * Do this by adjusting merge_graph.maxvar.
+ * Do this by adjusting merge_graph->maxvar.
+ */
+static isl_stat setup_merge_graph(isl_ctx *ctx, struct isl_sched_graph *graph,
+	struct isl_clustering *c, struct isl_sched_graph *merge_graph)
+{
+	if (init_merge_graph(ctx, graph, c, merge_graph) < 0)
+		return isl_stat_error;
+	share_merge_cache(c, merge_graph);
+
+	if (compute_maxvar(merge_graph) < 0)
+		return isl_stat_error;
+	return adjust_maxvar_to_slack(ctx, merge_graph, c);
+}
+
+/* Return the position of the merge graph in c->spec that was
+ * constructed for the SCCs currently marked in c->scc_in_merge or
+ * -1 if there is no such merge graph.
+ */
+static int find_speculated_merge(struct isl_clustering *c)
+{
+	int i;
+
+	for (i = 0; i < c->n_spec; ++i)
+		if (!memcmp(c->spec[i].scc_in_merge, c->scc_in_merge,
+			    c->n * sizeof(int)))
+			return i;
+
+	return -1;
+}
+
+/* Remove the merge graph at position "pos" from c->spec and
+ * store it in "merge_graph".
+ */
+static void take_speculated_merge(struct isl_clustering *c, int pos,
+	struct isl_sched_graph *merge_graph)
+{
+	*merge_graph = c->spec[pos].graph;
+	free(c->spec[pos].scc_in_merge);
+	c->n_spec--;
+	memmove(&c->spec[pos], &c->spec[pos + 1],
+		(c->n_spec - pos) * sizeof(struct isl_sched_merge_spec));
+}
+
+/* Collect in "edges" the indices of the (at most "n") edges in "graph"
+ * along which the clusters in "c" would be merged in turn
+ * if each of these merges were to fail, starting with the edge
+ * with index "edge".
+ * Return the number of collected edges or -1 on error.
+ *
+ * In particular, call find_proximity repeatedly, with the edges
+ * that have been collected so far temporarily marked "no_merge".
+ * This ignores any effect of a failed merge on the weights of the edges,
+ * so the edges along which merges are actually attempted
+ * may be different.
+ */
+static int collect_merge_candidates(struct isl_sched_graph *graph,
+	struct isl_clustering *c, int edge, int n, int *edges)
+{
+	int i, n_edge;
+	int next = 0;
+
+	edges[0] = edge;
+	graph->edge[edge].no_merge = 1;
+	for (n_edge = 1; n_edge < n; ++n_edge) {
+		next = find_proximity(graph, c);
+		if (next < 0 || next >= graph->n_edge)
+			break;
+		edges[n_edge] = next;
+		graph->edge[next].no_merge = 1;
+	}
+	for (i = 0; i < n_edge; ++i)
+		graph->edge[edges[i]].no_merge = 0;
+
+	return next < 0 ? -1 : n_edge;
+}
+
+/* Data structure for compute_merge_task.
+ *
+ * "spec" contains the merge graphs constructed by speculate_merges.
+ * The copy of each of these graphs on which the cluster schedule
+ * is computed is stored in "graph", with "graph_ctx" the context
+ * in which the corresponding task was run and
+ * "stats" the statistics collected by the task.
+ */
+struct isl_sched_merge_data {
+	struct isl_sched_merge_spec *spec;
+	struct isl_sched_graph *graph;
+	isl_ctx **graph_ctx;
+	struct isl_sched_stats *stats;
+};
+
+/* Compute the cluster schedule of the merge graph at position "pos"
+ * of data->spec on a copy of this graph in "ctx",
+ * stored in data->graph[pos].
+ */
+static isl_stat compute_merge_task(isl_ctx *ctx, int pos, void *user)
+{
+	struct isl_sched_merge_data *data = user;
+	struct isl_sched_graph *graph = &data->graph[pos];
+
+	data->graph_ctx[pos] = ctx;
+	if (graph_transfer(ctx, graph, &data->spec[pos].graph) < 0)
+		return isl_stat_error;
+	graph->stats = &data->stats[pos];
+
+	return compute_schedule_wcc_band(ctx, graph);
+}
+
+/* Free all memory allocated for "data", with "n" the number
+ * of merge graphs.
+ * The copies of the merge graphs live in the contexts
+ * in which they were constructed, but all tasks have finished
+ * by the time this function is called.
+ */
+static void merge_data_free(struct isl_sched_merge_data *data, int n)
+{
+	int i;
+
+	if (data->graph && data->graph_ctx)
+		for (i = 0; i < n; ++i)
+			if (data->graph_ctx[i])
+				graph_free(data->graph_ctx[i], &data->graph[i]);
+	free(data->graph);
+	free(data->graph_ctx);
+	free(data->stats);
+}
+
+/* Copy the cluster schedule that was computed on "src"
+ * by compute_merge_task back to "dst", the merge graph
+ * from which "src" was copied, transferring it to "ctx".
+ * The coincident arrays are shared by the nodes of "src" and "dst".
+ */
+static isl_stat merge_graph_copy_band(isl_ctx *ctx,
+	struct isl_sched_graph *dst, struct isl_sched_graph *src)
+{
+	int i;
+
+	for (i = 0; i < dst->n; ++i) {
+		struct isl_sched_node *node = &dst->node[i];
+
+		isl_mat_free(node->sched);
+		node->sched = isl_mat_dup_to_ctx(src->node[i].sched, ctx);
+		node->sched_map = isl_map_free(node->sched_map);
+		if (!node->sched)
+			return isl_stat_error;
+	}
+	dst->n_row = src->n_row;
+	dst->n_total_row = src->n_total_row;
+	dst->band_start = src->band_start;
+
+	return isl_stat_ok;
+}
+
+/* Construct and schedule merge graphs for the clusters of SCCs
+ * marked in c->scc_in_merge, which are about to be merged along
+ * the edge with index "edge", as well as for the clusters that
+ * would be merged next if this merge were to fail,
+ * replacing any earlier such merge graphs in c->spec.
+ * The number of merge candidates is determined by
+ * the thread_pool_size option.
+ * Candidates that would merge the same clusters
+ * as an earlier candidate are skipped.
+ *
+ * The merge graphs are constructed up front in "ctx",
+ * since this involves the clusters in "c".
+ * The cluster schedules are then computed as separate tasks,
+ * each of which only takes references to the objects
+ * in its own merge graph, and transferred back to "ctx"
+ * once all tasks have finished.
+ * The statistics collected by the tasks are added to those of "graph".
+ * On return, c->scc_in_merge is the same as on input.
+ */
+static isl_stat speculate_merges(isl_ctx *ctx, struct isl_sched_graph *graph,
+	struct isl_clustering *c, int edge)
+{
+	int i, n;
+	int *edges;
+	isl_stat r;
+	struct isl_sched_merge_data data = { 0 };
+
+	clear_speculated_merges(ctx, c);
+
+	n = ctx->opt->thread_pool_size;
+	edges = isl_alloc_array(ctx, int, n);
+	c->spec = isl_calloc_array(ctx, struct isl_sched_merge_spec, n);
+	if (!edges || !c->spec)
+		goto error;
+	n = collect_merge_candidates(graph, c, edge, n, edges);
+	if (n < 0)
+		goto error;
+	for (i = 0; i < n; ++i) {
+		struct isl_sched_merge_spec *spec = &c->spec[c->n_spec];
+
+		if (i > 0 && mark_merge_sccs(ctx, graph, edges[i], c) < 0)
+			goto error;
+		if (find_speculated_merge(c) >= 0)
+			continue;
+		spec->scc_in_merge = isl_alloc_array(ctx, int, c->n);
+		if (!spec->scc_in_merge)
+			goto error;
+		memcpy(spec->scc_in_merge, c->scc_in_merge,
+			c->n * sizeof(int));
+		c->n_spec++;
+		if (setup_merge_graph(ctx, graph, c, &spec->graph) < 0)
+			goto error;
+	}
+	free(edges);
+	memcpy(c->scc_in_merge, c->spec[0].scc_in_merge, c->n * sizeof(int));
+
+	data.spec = c->spec;
+	data.graph = isl_calloc_array(ctx, struct isl_sched_graph, c->n_spec);
+	data.graph_ctx = isl_calloc_array(ctx, isl_ctx *, c->n_spec);
+	data.stats = isl_calloc_array(ctx, struct isl_sched_stats, c->n_spec);
+	if (!data.graph || !data.graph_ctx || !data.stats) {
+		merge_data_free(&data, c->n_spec);
+		return isl_stat_error;
+	}
+
+	r = isl_ctx_run_tasks(ctx, c->n_spec, &compute_merge_task, &data);
+	for (i = 0; i < c->n_spec; ++i)
+		sched_stats_add(graph->stats, &data.stats[i]);
+	for (i = 0; r >= 0 && i < c->n_spec; ++i)
+		r = merge_graph_copy_band(ctx, &c->spec[i].graph,
+					&data.graph[i]);
+
+	merge_data_free(&data, c->n_spec);
+	return r;
+error:
+	free(edges);
+	return isl_stat_error;
+}
+
+/* Should merge candidates be scheduled ahead of time
+ * by speculate_merges?
+ * This only makes sense if the candidates are scheduled concurrently.
+ * Otherwise, the merge graphs would be scheduled one after the other,
+ * while most of them are discarded.
+ */
+static int use_speculation(isl_ctx *ctx)
+{
+	return isl_options_get_schedule_concurrent_merge(ctx) &&
+		isl_ctx_runs_tasks_concurrently(ctx);
+}
+
+/* Try and merge the clusters of SCCs marked in c->scc_in_merge,
+ * which are connected by the edge with index "edge",
+ * by scheduling the current cluster bands with respect to each other.
+ *
+ * Construct a dependence graph with a space for each cluster and
+ * with the coordinates of each space corresponding to the schedule
+ * dimensions of the current band of that cluster.
+ * Construct a cluster schedule in this cluster dependence graph and
+ * apply it to the current cluster bands if it is applicable
+ * according to ok_to_merge.
+ *
+ * If a merge graph has already been constructed and scheduled
+ * for these clusters by speculate_merges, then use that instead.
+ * Otherwise, if merge candidates should be scheduled ahead of time,
+ * then call speculate_merges first.
+ * Since the clusters change after a successful merge,
+ * any remaining merge graphs are discarded in this case.
  *
  * Return isl_bool_true if the clusters have effectively been merged
  * into a single cluster.
@@ -6196,23 +7698,34 @@ static isl_stat merge(isl_ctx *ctx, struct isl_clustering *c,
  * scheduling algorithm.
  */
 static isl_bool try_merge(isl_ctx *ctx, struct isl_sched_graph *graph,
-	struct isl_clustering *c)
+	int edge, struct isl_clustering *c)
 {
 	struct isl_sched_graph merge_graph = { 0 };
 	isl_bool merged;
+	int pos;
 
-	if (init_merge_graph(ctx, graph, c, &merge_graph) < 0)
-		goto error;
-
-	if (compute_maxvar(&merge_graph) < 0)
-		goto error;
-	if (adjust_maxvar_to_slack(ctx, &merge_graph,c) < 0)
-		goto error;
-	if (compute_schedule_wcc_band(ctx, &merge_graph) < 0)
-		goto error;
+	pos = find_speculated_merge(c);
+	if (pos < 0 && use_speculation(ctx)) {
+		if (speculate_merges(ctx, graph, c, edge) < 0)
+			goto error;
+		pos = find_speculated_merge(c);
+	}
+	if (pos >= 0) {
+		take_speculated_merge(c, pos, &merge_graph);
+	} else {
+		if (setup_merge_graph(ctx, graph, c, &merge_graph) < 0)
+			goto error;
+		if (compute_schedule_wcc_band(ctx, &merge_graph) < 0)
+			goto error;
+	}
 	merged = ok_to_merge(ctx, graph, c, &merge_graph);
 	if (merged && merge(ctx, c, &merge_graph) < 0)
 		goto error;
+	if (merged) {
+		coef_cache_free(c->merge_cache);
+		c->merge_cache = NULL;
+		clear_speculated_merges(ctx, c);
+	}
 
 	graph_free(ctx, &merge_graph);
 	return merged;
@@ -6274,6 +7787,7 @@ static int any_no_merge(struct isl_sched_graph *graph, int *scc_in_merge,
  * if the clusters did not end up getting merged, unless the non-merge
  * is due to the fact that the edge was postponed.  This postponement
  * can be recognized by a change in weight (from non-negative to negative).
+ * Any attempt at merging the clusters is recorded in graph->stats.
  */
 static isl_stat merge_clusters_along_edge(isl_ctx *ctx,
 	struct isl_sched_graph *graph, int edge, struct isl_clustering *c)
@@ -6284,12 +7798,19 @@ static isl_stat merge_clusters_along_edge(isl_ctx *ctx,
 	if (mark_merge_sccs(ctx, graph, edge, c) < 0)
 		return isl_stat_error;
 
-	if (any_no_merge(graph, c->scc_in_merge, &graph->edge[edge]))
+	if (any_no_merge(graph, c->scc_in_merge, &graph->edge[edge])) {
 		merged = isl_bool_false;
-	else
-		merged = try_merge(ctx, graph, c);
+	} else {
+		uint64_t start = isl_clock_us();
+
+		merged = try_merge(ctx, graph, edge, c);
+		graph->stats->n_merge_attempt++;
+		graph->stats->merge_us += isl_clock_us() - start;
+	}
 	if (merged < 0)
 		return isl_stat_error;
+	if (merged)
+		graph->stats->n_merge++;
 	if (!merged && edge_weight == graph->edge[edge].weight)
 		graph->edge[edge].no_merge = 1;
 
@@ -6537,8 +8058,8 @@ static __isl_give isl_schedule_node *finish_bands_clustering(
  * Initially, each cluster consists of a single SCC, each with its
  * own band schedule.  The algorithm then tries to merge pairs
  * of clusters along a proximity edge until no more suitable
- * proximity edges can be found.  During this merging, the schedule
- * is maintained in the individual SCCs.
+ * proximity edges can be found or until the time budget expires.
+ * During this merging, the schedule is maintained in the individual SCCs.
  * After the merging is completed, the full resulting clusters
  * are extracted and in finish_bands_clustering,
  * compute_schedule_finish_band is called on each of them to integrate
@@ -6562,6 +8083,10 @@ static __isl_give isl_schedule_node *compute_schedule_wcc_clustering(
 		goto error;
 
 	for (;;) {
+		if (isl_ctx_check_interrupt(ctx) < 0)
+			goto error;
+		if (budget_expired(graph))
+			break;
 		i = find_proximity(graph, &c);
 		if (i < 0)
 			goto error;
@@ -6597,6 +8122,15 @@ error:
  * there is no point in trying to combine SCCs
  * in compute_schedule_wcc_clustering, so compute_schedule_wcc_whole
  * is called instead.
+ *
+ * If the time budget has expired, then the schedule is computed
+ * using the fallback algorithm instead, inside a "degraded" mark node.
+ * This fallback algorithm is Feautrier's algorithm, with
+ * the extension to a full-dimensional schedule being performed
+ * without trying to combine SCCs.
+ * The SCCs are also not combined if the outermost band
+ * is (partly) imposed by a previous schedule since merging clusters
+ * recombines the rows of their bands.
  */
 static __isl_give isl_schedule_node *compute_schedule_wcc(
 	__isl_take isl_schedule_node *node, struct isl_sched_graph *graph)
@@ -6606,6 +8140,12 @@ static __isl_give isl_schedule_node *compute_schedule_wcc(
 	if (!node)
 		return NULL;
 
+	if (budget_expired(graph)) {
+		node = start_degraded(node, graph);
+		node = compute_schedule_wcc(node, graph);
+		return isl_schedule_node_parent(node);
+	}
+
 	ctx = isl_schedule_node_get_ctx(node);
 	if (detect_sccs(ctx, graph) < 0)
 		return isl_schedule_node_free(node);
@@ -6616,12 +8156,152 @@ static __isl_give isl_schedule_node *compute_schedule_wcc(
 	if (need_feautrier_step(ctx, graph))
 		return compute_schedule_wcc_feautrier(node, graph);
 
-	if (graph->scc <= 1 || isl_options_get_schedule_whole_component(ctx))
+	if (graph->scc <= 1 || graph->degraded || has_fixed_row(graph) ||
+	    isl_options_get_schedule_whole_component(ctx))
 		return compute_schedule_wcc_whole(node, graph);
 	else
 		return compute_schedule_wcc_clustering(node, graph);
 }
 
+/* Data structure for compute_component_task.
+ *
+ * "wcc" is passed to compute_sub_schedule.
+ * "sub" contains the subgraph of each component and
+ * "filters" the corresponding domains.
+ * The schedule tree computed for each component is stored in "tree",
+ * in the context in which the corresponding task was run.
+ * The statistics collected by each task are stored in "stats".
+ */
+struct isl_sched_component_data {
+	int wcc;
+	struct isl_sched_graph *sub;
+	isl_union_set_list *filters;
+	isl_schedule_tree **tree;
+	struct isl_sched_stats *stats;
+};
+
+/* Compute a schedule for component "pos" of data->sub in "ctx" and
+ * store the resulting schedule tree in data->tree[pos].
+ * The subgraph and its domain are first transferred to "ctx" and
+ * the schedule is computed on a schedule tree with the domain
+ * of the component as root, in the same way as in compute_sub_schedule.
+ * Statistics are collected in data->stats[pos] since the statistics
+ * of the original graph may be updated by other tasks.
+ */
+static isl_stat compute_component_task(isl_ctx *ctx, int pos, void *user)
+{
+	struct isl_sched_component_data *data = user;
+	struct isl_sched_graph graph = { 0 };
+	isl_union_set *domain;
+	isl_schedule *schedule;
+	isl_schedule_node *node;
+
+	if (graph_transfer(ctx, &graph, &data->sub[pos]) < 0)
+		goto error;
+	graph.stats = &data->stats[pos];
+
+	domain = isl_union_set_list_get_union_set(data->filters, pos);
+	domain = isl_union_set_transfer(domain, ctx);
+	schedule = isl_schedule_from_domain(domain);
+	node = isl_schedule_get_root(schedule);
+	isl_schedule_free(schedule);
+	node = isl_schedule_node_child(node, 0);
+	if (data->wcc)
+		node = compute_schedule_wcc(node, &graph);
+	else
+		node = compute_schedule(node, &graph);
+	data->tree[pos] = isl_schedule_node_get_tree(node);
+	isl_schedule_node_free(node);
+
+	graph_free(ctx, &graph);
+	return data->tree[pos] ? isl_stat_ok : isl_stat_error;
+error:
+	graph_free(ctx, &graph);
+	return isl_stat_error;
+}
+
+/* Free all memory allocated for "data", with "n" the number
+ * of components.
+ */
+static void component_data_free(isl_ctx *ctx,
+	struct isl_sched_component_data *data, int n)
+{
+	int i;
+
+	if (data->sub)
+		for (i = 0; i < n; ++i)
+			graph_free(ctx, &data->sub[i]);
+	free(data->sub);
+	if (data->tree)
+		for (i = 0; i < n; ++i)
+			isl_schedule_tree_free(data->tree[i]);
+	free(data->tree);
+	free(data->stats);
+	isl_union_set_list_free(data->filters);
+}
+
+/* Compute a schedule for each group of nodes identified by node->scc
+ * as a separate task, where "node" points to the sequence or set node
+ * with a filter child for each of the groups, in the order specified
+ * by "filters".
+ * Return the updated schedule node.
+ *
+ * The subgraphs are extracted up front, since this involves "ctx".
+ * Each task then only takes references to the objects
+ * in its own subgraph.
+ * The schedule trees computed by the tasks are transferred back to "ctx"
+ * once all tasks have finished and grafted into the schedule tree
+ * in the order of the components, such that the result
+ * is the same as that of computing the schedules one after the other.
+ * The statistics collected by the tasks are added to those of "graph".
+ */
+static __isl_give isl_schedule_node *compute_components_as_tasks(
+	__isl_take isl_schedule_node *node, isl_ctx *ctx,
+	struct isl_sched_graph *graph, int wcc,
+	__isl_take isl_union_set_list *filters)
+{
+	int component;
+	isl_stat r;
+	struct isl_sched_component_data data = { wcc };
+
+	data.filters = filters;
+	data.sub = isl_calloc_array(ctx, struct isl_sched_graph, graph->scc);
+	data.tree = isl_calloc_array(ctx, isl_schedule_tree *, graph->scc);
+	data.stats = isl_calloc_array(ctx, struct isl_sched_stats, graph->scc);
+	if (!node || !data.filters || !data.sub || !data.tree || !data.stats)
+		goto error;
+
+	for (component = 0; component < graph->scc; ++component)
+		if (extract_sub_graph(ctx, graph, &node_scc_exactly,
+				&edge_scc_exactly, component,
+				&data.sub[component]) < 0)
+			goto error;
+
+	r = isl_ctx_run_tasks(ctx, graph->scc, &compute_component_task, &data);
+	for (component = 0; component < graph->scc; ++component)
+		sched_stats_add(graph->stats, &data.stats[component]);
+	if (r < 0)
+		goto error;
+
+	for (component = 0; component < graph->scc; ++component) {
+		isl_schedule_tree *tree;
+
+		tree = isl_schedule_tree_transfer(data.tree[component], ctx);
+		data.tree[component] = NULL;
+		node = isl_schedule_node_child(node, component);
+		node = isl_schedule_node_child(node, 0);
+		node = isl_schedule_node_graft_tree(node, tree);
+		node = isl_schedule_node_parent(node);
+		node = isl_schedule_node_parent(node);
+	}
+
+	component_data_free(ctx, &data, graph->scc);
+	return node;
+error:
+	component_data_free(ctx, &data, graph->scc);
+	return isl_schedule_node_free(node);
+}
+
 /* Compute a schedule for each group of nodes identified by node->scc
  * separately and then combine them in a sequence node (or as set node
  * if graph->weak is set) inserted at position "node" of the schedule tree.
@@ -6631,6 +8311,10 @@ static __isl_give isl_schedule_node *compute_schedule_wcc(
  * weakly connected component in the dependence graph so that
  * there is no need for compute_sub_schedule to look for weakly
  * connected components.
+ *
+ * If the schedule_concurrent_components option is set, then
+ * the schedules of the groups are computed
+ * by compute_components_as_tasks instead.
  */
 static __isl_give isl_schedule_node *compute_component_schedule(
 	__isl_take isl_schedule_node *node, struct isl_sched_graph *graph,
@@ -6646,9 +8330,16 @@ static __isl_give isl_schedule_node *compute_component_schedule(
 
 	filters = extract_sccs(ctx, graph);
 	if (graph->weak)
-		node = isl_schedule_node_insert_set(node, filters);
+		node = isl_schedule_node_insert_set(node,
+					isl_union_set_list_copy(filters));
 	else
-		node = isl_schedule_node_insert_sequence(node, filters);
+		node = isl_schedule_node_insert_sequence(node,
+					isl_union_set_list_copy(filters));
+
+	if (isl_options_get_schedule_concurrent_components(ctx))
+		return compute_components_as_tasks(node, ctx, graph, wcc,
+						    filters);
+	isl_union_set_list_free(filters);
 
 	for (component = 0; component < graph->scc; ++component) {
 		node = isl_schedule_node_child(node, component);
@@ -6696,6 +8387,150 @@ static __isl_give isl_schedule_node *compute_schedule(isl_schedule_node *node,
 	return compute_schedule_wcc(node, graph);
 }
 
+/* Store the affine expression "aff" defined over the (uncompressed)
+ * domain of "node" in row "row" of node->fixed, in the same format
+ * as node->sched.
+ * "aff" is assumed to have been aligned to the parameters of "node".
+ * Return isl_bool_false if "aff" cannot be represented in this format,
+ * i.e., if it is not an integral affine expression (after compression)
+ * or if it involves parameters that are not used
+ * in the schedule of "node".
+ */
+static isl_bool set_fixed_row(struct isl_sched_node *node, int row,
+	__isl_take isl_aff *aff)
+{
+	int j;
+	int n_param, n_div;
+	isl_bool ok = isl_bool_true;
+
+	if (node->compressed)
+		aff = isl_aff_pullback_multi_aff(aff,
+					isl_multi_aff_copy(node->decompress));
+	if (!aff)
+		return isl_bool_error;
+
+	n_param = isl_aff_dim(aff, isl_dim_param);
+	n_div = isl_aff_dim(aff, isl_dim_div);
+	if (!isl_int_is_one(aff->v->el[0]))
+		ok = isl_bool_false;
+	if (ok == isl_bool_true && n_div > 0)
+		ok = isl_bool_not(isl_aff_involves_dims(aff,
+						isl_dim_div, 0, n_div));
+	if (ok == isl_bool_true && n_param > node->nparam)
+		ok = isl_bool_not(isl_aff_involves_dims(aff, isl_dim_param,
+					node->nparam, n_param - node->nparam));
+	if (ok <= 0) {
+		isl_aff_free(aff);
+		return ok;
+	}
+
+	isl_int_set(node->fixed->row[row][0], aff->v->el[1]);
+	for (j = 0; j < node->nparam; ++j)
+		isl_int_set(node->fixed->row[row][1 + j], aff->v->el[2 + j]);
+	for (j = 0; j < node->nvar; ++j)
+		isl_int_set(node->fixed->row[row][1 + node->nparam + j],
+			    aff->v->el[2 + n_param + j]);
+
+	isl_aff_free(aff);
+	return isl_bool_true;
+}
+
+/* Set node->fixed to the rows of "mupa" on the domain of "node",
+ * as far as they can be represented in the format of node->sched.
+ * In particular, a row can only be represented if it is defined
+ * by a single affine expression on the domain of "node".
+ * Only the initial rows that can be represented are kept.
+ */
+static isl_stat node_set_fixed(struct isl_sched_node *node,
+	__isl_keep isl_multi_union_pw_aff *mupa)
+{
+	int i, n;
+	isl_ctx *ctx;
+	isl_space *space;
+
+	ctx = isl_space_get_ctx(node->space);
+	n = isl_multi_union_pw_aff_dim(mupa, isl_dim_set);
+	node->fixed = isl_mat_alloc(ctx, n, 1 + node->nparam + node->nvar);
+	if (!node->fixed)
+		return isl_stat_error;
+
+	space = isl_space_from_domain(isl_space_copy(node->space));
+	space = isl_space_add_dims(space, isl_dim_out, 1);
+	for (i = 0; i < n; ++i) {
+		isl_union_pw_aff *upa;
+		isl_pw_aff *pa;
+		isl_aff *aff = NULL;
+		isl_bool ok;
+
+		upa = isl_multi_union_pw_aff_get_union_pw_aff(mupa, i);
+		pa = isl_union_pw_aff_extract_pw_aff(upa,
+						isl_space_copy(space));
+		isl_union_pw_aff_free(upa);
+		if (!pa)
+			goto error;
+		if (pa->n == 1)
+			aff = isl_aff_copy(pa->p[0].aff);
+		isl_pw_aff_free(pa);
+		if (!aff)
+			break;
+		ok = set_fixed_row(node, i, aff);
+		if (ok < 0)
+			goto error;
+		if (!ok)
+			break;
+	}
+	isl_space_free(space);
+
+	if (i == 0)
+		node->fixed = isl_mat_free(node->fixed);
+	else
+		node->fixed = isl_mat_drop_rows(node->fixed, i, n - i);
+	if (i != 0 && !node->fixed)
+		return isl_stat_error;
+
+	return isl_stat_ok;
+error:
+	isl_space_free(space);
+	return isl_stat_error;
+}
+
+/* Initialize the "fixed" field of the nodes of "graph"
+ * from the outermost band of "schedule", if any.
+ * The rows of this band are expressed in terms of the parameters
+ * of "graph", if possible.
+ * Nodes that do not appear in "schedule" remain free.
+ */
+static isl_stat graph_set_fixed(struct isl_sched_graph *graph,
+	__isl_keep isl_schedule *schedule)
+{
+	int i;
+	isl_schedule_node *node;
+	isl_multi_union_pw_aff *mupa;
+	isl_space *space;
+
+	node = isl_schedule_get_root(schedule);
+	node = isl_schedule_node_child(node, 0);
+	if (!node)
+		return isl_stat_error;
+	if (isl_schedule_node_get_type(node) != isl_schedule_node_band) {
+		isl_schedule_node_free(node);
+		return isl_stat_ok;
+	}
+	mupa = isl_schedule_node_band_get_partial_schedule(node);
+	isl_schedule_node_free(node);
+	space = isl_space_params(isl_space_copy(graph->node[0].space));
+	mupa = isl_multi_union_pw_aff_align_params(mupa, space);
+	if (!mupa)
+		return isl_stat_error;
+
+	for (i = 0; i < graph->n; ++i)
+		if (node_set_fixed(&graph->node[i], mupa) < 0)
+			break;
+
+	isl_multi_union_pw_aff_free(mupa);
+	return i < graph->n ? isl_stat_error : isl_stat_ok;
+}
+
 /* Compute a schedule on sc->domain that respects the given schedule
  * constraints.
  *
@@ -6710,16 +8545,40 @@ static __isl_give isl_schedule_node *compute_schedule(isl_schedule_node *node,
  * then the conditional validity dependences may be violated inside
  * a tilable band, provided they have no adjacent non-local
  * condition dependences.
+ *
+ * If "deadline" is not zero, then the computation switches
+ * to the fallback algorithm once this deadline has passed.
+ * The deadline covers the construction of the dependence graph.
+ *
+ * Statistics about the computation are collected in ctx->sched_stats,
+ * replacing those of any earlier computation.
+ *
+ * If "prev" is not NULL, then the rows of its outermost band
+ * are imposed on the statements that appear in "prev",
+ * for as long as they remain valid.
  */
-__isl_give isl_schedule *isl_schedule_constraints_compute_schedule(
-	__isl_take isl_schedule_constraints *sc)
+static __isl_give isl_schedule *compute_schedule_from(
+	__isl_take isl_schedule_constraints *sc, __isl_keep isl_schedule *prev,
+	uint64_t deadline)
 {
 	isl_ctx *ctx = isl_schedule_constraints_get_ctx(sc);
 	struct isl_sched_graph graph = { 0 };
 	isl_schedule *sched;
 	isl_schedule_node *node;
 	isl_union_set *domain;
+	uint64_t start;
+
+	if (!sc)
+		return NULL;
 
+	start = isl_clock_us();
+	if (!ctx->sched_stats)
+		ctx->sched_stats = isl_alloc_type(ctx, struct isl_sched_stats);
+	if (!ctx->sched_stats) {
+		isl_schedule_constraints_free(sc);
+		return NULL;
+	}
+	memset(ctx->sched_stats, 0, sizeof(struct isl_sched_stats));
 	sc = isl_schedule_constraints_align_params(sc);
 
 	domain = isl_schedule_constraints_get_domain(sc);
@@ -6728,8 +8587,13 @@ __isl_give isl_schedule *isl_schedule_constraints_compute_schedule(
 		return isl_schedule_from_domain(domain);
 	}
 
+	graph.stats = ctx->sched_stats;
 	if (graph_init(&graph, sc) < 0)
 		domain = isl_union_set_free(domain);
+	else if (prev && graph.n > 0 && graph_set_fixed(&graph, prev) < 0)
+		domain = isl_union_set_free(domain);
+	graph.deadline = deadline;
+	ctx->sched_stats->graph_init_us = isl_clock_us() - start;
 
 	node = isl_schedule_node_from_domain(domain);
 	node = isl_schedule_node_child(node, 0);
@@ -6741,9 +8605,173 @@ __isl_give isl_schedule *isl_schedule_constraints_compute_schedule(
 	graph_free(ctx, &graph);
 	isl_schedule_constraints_free(sc);
 
+	ctx->sched_stats->total_us = isl_clock_us() - start;
+
 	return sched;
 }
 
+/* Return the deadline corresponding to the schedule_budget option
+ * of the context of "sc", starting from the current time,
+ * or 0 if no budget has been set.
+ */
+static uint64_t budget_deadline(__isl_keep isl_schedule_constraints *sc)
+{
+	isl_ctx *ctx = isl_schedule_constraints_get_ctx(sc);
+
+	if (!ctx || ctx->opt->schedule_budget <= 0)
+		return 0;
+	return isl_deadline_from_timeout(ctx->opt->schedule_budget);
+}
+
+/* Compute a schedule on sc->domain that respects the given schedule
+ * constraints.
+ * If the schedule_budget option is set, then the time budget
+ * starts running here.
+ */
+__isl_give isl_schedule *isl_schedule_constraints_compute_schedule(
+	__isl_take isl_schedule_constraints *sc)
+{
+	return compute_schedule_from(sc, NULL, budget_deadline(sc));
+}
+
+/* Compute a schedule on sc->domain that respects the given schedule
+ * constraints, switching to the fallback algorithm
+ * once "deadline" (as returned by isl_deadline_from_timeout)
+ * has passed, independently of the schedule_budget option.
+ * A deadline of zero means that the computation is not limited.
+ */
+__isl_give isl_schedule *isl_schedule_constraints_compute_schedule_before(
+	__isl_take isl_schedule_constraints *sc, uint64_t deadline)
+{
+	return compute_schedule_from(sc, NULL, deadline);
+}
+
+/* Compute a schedule on sc->domain that respects the given schedule
+ * constraints, reusing as much as possible of the outermost band
+ * of "schedule", a schedule previously computed for (a variant of)
+ * the same problem.
+ * In particular, the statements that appear in both sc->domain and
+ * "schedule" keep the rows of the outermost band of "schedule"
+ * for as long as these rows remain valid with respect to
+ * the schedule constraints, such that the scheduler effectively
+ * only needs to determine the schedule rows of the new statements.
+ * The first row that cannot be preserved and all subsequent rows
+ * are computed from scratch.
+ */
+__isl_give isl_schedule *isl_schedule_constraints_recompute_schedule(
+	__isl_take isl_schedule_constraints *sc,
+	__isl_take isl_schedule *schedule)
+{
+	isl_schedule *res;
+
+	if (!schedule) {
+		isl_schedule_constraints_free(sc);
+		return NULL;
+	}
+
+	res = compute_schedule_from(sc, schedule, budget_deadline(sc));
+	isl_schedule_free(schedule);
+
+	return res;
+}
+
+/* Print a YAML mapping entry with key "name" and value "v" to "p".
+ */
+static __isl_give isl_printer *print_count_field(__isl_take isl_printer *p,
+	const char *name, long v)
+{
+	isl_val *val;
+
+	val = isl_val_int_from_si(isl_printer_get_ctx(p), v);
+	p = isl_printer_print_str(p, name);
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_print_val(p, val);
+	p = isl_printer_yaml_next(p);
+	isl_val_free(val);
+
+	return p;
+}
+
+/* Print a YAML mapping entry with key "name" and
+ * the time "us" (in microseconds) expressed in milliseconds as value to "p".
+ */
+static __isl_give isl_printer *print_time_field(__isl_take isl_printer *p,
+	const char *name, uint64_t us)
+{
+	p = isl_printer_print_str(p, name);
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_print_double(p, us / 1000.0);
+	p = isl_printer_yaml_next(p);
+
+	return p;
+}
+
+/* Print the statistics "stats" about the (I)LP problems of some kind
+ * as the value of a YAML mapping entry with key "name" to "p".
+ */
+static __isl_give isl_printer *print_lp_stats(__isl_take isl_printer *p,
+	const char *name, struct isl_sched_lp_stats *stats)
+{
+	p = isl_printer_print_str(p, name);
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_yaml_start_mapping(p);
+	p = print_count_field(p, "count", stats->n);
+	p = print_time_field(p, "time_ms", stats->us);
+	p = print_count_field(p, "pivots", stats->pivots);
+	p = print_count_field(p, "max_variables", stats->max_var);
+	p = print_count_field(p, "max_constraints", stats->max_con);
+	p = isl_printer_yaml_end_mapping(p);
+	p = isl_printer_yaml_next(p);
+
+	return p;
+}
+
+/* Return a YAML description of the statistics collected
+ * during the most recent schedule computation in "ctx".
+ * If no schedule has been computed in "ctx" yet,
+ * then all entries are zero.
+ */
+__isl_give char *isl_ctx_schedule_stats_to_str(isl_ctx *ctx)
+{
+	struct isl_sched_stats empty = { 0 };
+	struct isl_sched_stats *stats;
+	isl_printer *p;
+	char *s;
+
+	if (!ctx)
+		return NULL;
+
+	stats = ctx->sched_stats ? ctx->sched_stats : &empty;
+	p = isl_printer_to_str(ctx);
+	p = isl_printer_set_yaml_style(p, ISL_YAML_STYLE_BLOCK);
+	p = isl_printer_yaml_start_mapping(p);
+	p = print_time_field(p, "total_ms", stats->total_us);
+	p = print_time_field(p, "graph_init_ms", stats->graph_init_us);
+	p = isl_printer_print_str(p, "duals");
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_yaml_start_mapping(p);
+	p = print_count_field(p, "count", stats->n_dual);
+	p = print_time_field(p, "time_ms", stats->dual_us);
+	p = print_count_field(p, "farkas", stats->n_farkas);
+	p = print_count_field(p, "generators", stats->n_generator);
+	p = isl_printer_yaml_end_mapping(p);
+	p = isl_printer_yaml_next(p);
+	p = print_lp_stats(p, "band_lp", &stats->band);
+	p = print_lp_stats(p, "carry_lp", &stats->carry);
+	p = isl_printer_print_str(p, "merge");
+	p = isl_printer_yaml_next(p);
+	p = isl_printer_yaml_start_mapping(p);
+	p = print_count_field(p, "attempts", stats->n_merge_attempt);
+	p = print_count_field(p, "successes", stats->n_merge);
+	p = print_time_field(p, "time_ms", stats->merge_us);
+	p = isl_printer_yaml_end_mapping(p);
+	p = isl_printer_yaml_end_mapping(p);
+	s = isl_printer_get_str(p);
+	isl_printer_free(p);
+
+	return s;
+}
+
 /* Compute a schedule for the given union of domains that respects
  * all the validity dependences and minimizes
  * the dependence distances over the proximity dependences.
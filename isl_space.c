@@ -17,6 +17,7 @@
 #include <isl_space_private.h>
 #include <isl_id_private.h>
 #include <isl_reordering.h>
+#include <isl_refcount.h>
 
 isl_ctx *isl_space_get_ctx(__isl_keep isl_space *dim)
 {
@@ -318,15 +319,23 @@ error:
 	return NULL;
 }
 
+/* Return a version of "dim" that can be modified.
+ * If "dim" is shared, then the duplicate is constructed before
+ * the reference to "dim" is released such that "dim" is guaranteed
+ * to remain valid while it is being duplicated.
+ */
 __isl_give isl_space *isl_space_cow(__isl_take isl_space *dim)
 {
+	isl_space *dup;
+
 	if (!dim)
 		return NULL;
 
-	if (dim->ref == 1)
+	if (isl_refcount_get(dim->ref) == 1)
 		return dim;
-	dim->ref--;
-	return isl_space_dup(dim);
+	dup = isl_space_dup(dim);
+	isl_space_free(dim);
+	return dup;
 }
 
 __isl_give isl_space *isl_space_copy(__isl_keep isl_space *dim)
@@ -334,7 +343,7 @@ __isl_give isl_space *isl_space_copy(__isl_keep isl_space *dim)
 	if (!dim)
 		return NULL;
 
-	dim->ref++;
+	isl_refcount_inc(dim->ref);
 	return dim;
 }
 
@@ -345,7 +354,7 @@ __isl_null isl_space *isl_space_free(__isl_take isl_space *space)
 	if (!space)
 		return NULL;
 
-	if (--space->ref > 0)
+	if (isl_refcount_dec(space->ref) > 0)
 		return NULL;
 
 	isl_id_free(space->tuple_id[0]);
@@ -364,6 +373,62 @@ __isl_null isl_space *isl_space_free(__isl_take isl_space *space)
 	return NULL;
 }
 
+/* Return a copy of "space" that lives in "ctx".
+ * All identifiers, including those of nested spaces,
+ * are remapped through the identifier table of "ctx" using
+ * isl_id_transfer.
+ * If "space" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_space *isl_space_transfer(__isl_take isl_space *space,
+	isl_ctx *ctx)
+{
+	int i;
+	isl_space *res;
+
+	if (!space || !ctx)
+		return isl_space_free(space);
+	if (space->ctx == ctx)
+		return space;
+
+	res = isl_space_alloc(ctx, space->nparam, space->n_in, space->n_out);
+	if (!res)
+		goto error;
+	for (i = 0; i < 2; ++i) {
+		if (space->tuple_id[i]) {
+			res->tuple_id[i] = isl_id_transfer(
+				isl_id_copy(space->tuple_id[i]), ctx);
+			if (!res->tuple_id[i])
+				goto error;
+		}
+		if (space->nested[i]) {
+			res->nested[i] = isl_space_transfer(
+				isl_space_copy(space->nested[i]), ctx);
+			if (!res->nested[i])
+				goto error;
+		}
+	}
+	if (space->n_id > 0) {
+		res->ids = isl_calloc_array(ctx, isl_id *, space->n_id);
+		if (!res->ids)
+			goto error;
+		res->n_id = space->n_id;
+	}
+	for (i = 0; i < space->n_id; ++i) {
+		if (!space->ids[i])
+			continue;
+		res->ids[i] = isl_id_transfer(isl_id_copy(space->ids[i]), ctx);
+		if (!res->ids[i])
+			goto error;
+	}
+
+	isl_space_free(space);
+	return res;
+error:
+	isl_space_free(space);
+	isl_space_free(res);
+	return NULL;
+}
+
 /* Check if "s" is a valid dimension or tuple name.
  * We currently only forbid names that look like a number.
  *
@@ -3784,6 +3784,8 @@ static void find_solutions(struct isl_sol *sol, struct isl_tab *tab)
 
 	if (!tab || sol->error)
 		goto error;
+	if (isl_ctx_check_interrupt(isl_tab_get_ctx(tab)) < 0)
+		goto error;
 
 	context = sol->context;
 
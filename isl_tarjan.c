@@ -56,6 +56,37 @@ error:
 	return NULL;
 }
 
+/* Start visiting node "i" in Tarjan's algorithm.
+ */
+static void isl_tarjan_push(struct isl_tarjan_graph *g, int i)
+{
+	g->node[i].index = g->index;
+	g->node[i].min_index = g->index;
+	g->node[i].on_stack = 1;
+	g->index++;
+	g->stack[g->sp++] = i;
+}
+
+/* Finish visiting node "i" in Tarjan's algorithm.
+ * If "i" is the root of a strongly connected component,
+ * then move the elements of this component from the stack
+ * to g->order, followed by a -1 separator.
+ */
+static void isl_tarjan_pop(struct isl_tarjan_graph *g, int i)
+{
+	int j;
+
+	if (g->node[i].index != g->node[i].min_index)
+		return;
+
+	do {
+		j = g->stack[--g->sp];
+		g->node[j].on_stack = 0;
+		g->order[g->op++] = j;
+	} while (j != i);
+	g->order[g->op++] = -1;
+}
+
 /* Perform Tarjan's algorithm for computing the strongly connected components
  * in the graph with g->len nodes and with edges defined by "follows".
  */
@@ -64,11 +95,7 @@ static isl_stat isl_tarjan_components(struct isl_tarjan_graph *g, int i,
 {
 	int j;
 
-	g->node[i].index = g->index;
-	g->node[i].min_index = g->index;
-	g->node[i].on_stack = 1;
-	g->index++;
-	g->stack[g->sp++] = i;
+	isl_tarjan_push(g, i);
 
 	for (j = g->len - 1; j >= 0; --j) {
 		isl_bool f;
@@ -94,19 +121,45 @@ static isl_stat isl_tarjan_components(struct isl_tarjan_graph *g, int i,
 			g->node[i].min_index = g->node[j].index;
 	}
 
-	if (g->node[i].index != g->node[i].min_index)
-		return isl_stat_ok;
-
-	do {
-		j = g->stack[--g->sp];
-		g->node[j].on_stack = 0;
-		g->order[g->op++] = j;
-	} while (j != i);
-	g->order[g->op++] = -1;
+	isl_tarjan_pop(g, i);
 
 	return isl_stat_ok;
 }
 
+/* Perform Tarjan's algorithm for computing the strongly connected components
+ * in the graph with g->len nodes and with edges represented
+ * in compressed sparse row format by "start" and "follows".
+ * The nodes followed by a node are considered in decreasing order,
+ * as in isl_tarjan_components.
+ */
+static void isl_tarjan_components_csr(struct isl_tarjan_graph *g, int i,
+	const int *start, const int *follows)
+{
+	int k;
+
+	isl_tarjan_push(g, i);
+
+	for (k = start[i]; k < start[i + 1]; ++k) {
+		int j = follows[k];
+
+		if (j == i)
+			continue;
+		if (g->node[j].index >= 0 &&
+			(!g->node[j].on_stack ||
+			 g->node[j].index > g->node[i].min_index))
+			continue;
+
+		if (g->node[j].index < 0) {
+			isl_tarjan_components_csr(g, j, start, follows);
+			if (g->node[j].min_index < g->node[i].min_index)
+				g->node[i].min_index = g->node[j].min_index;
+		} else if (g->node[j].index < g->node[i].min_index)
+			g->node[i].min_index = g->node[j].index;
+	}
+
+	isl_tarjan_pop(g, i);
+}
+
 /* Decompose the graph with "len" nodes and edges defined by "follows"
  * into strongly connected components (SCCs).
  * follows(i, j, user) should return 1 if "i" follows "j" and 0 otherwise.
@@ -135,6 +188,36 @@ struct isl_tarjan_graph *isl_tarjan_graph_init(isl_ctx *ctx, int len,
 	return g;
 }
 
+/* Decompose the graph with "len" nodes into strongly connected
+ * components (SCCs), where the edges are represented
+ * in compressed sparse row format.
+ * In particular, node i follows the nodes
+ * follows[start[i]], ..., follows[start[i + 1] - 1],
+ * which are listed in decreasing order, without duplicates.
+ *
+ * The result is the same as that of isl_tarjan_graph_init
+ * with a "follows" callback that describes the same edges,
+ * but the running time is linear in the number of edges
+ * rather than quadratic in the number of nodes.
+ */
+struct isl_tarjan_graph *isl_tarjan_graph_init_csr(isl_ctx *ctx, int len,
+	const int *start, const int *follows)
+{
+	int i;
+	struct isl_tarjan_graph *g = NULL;
+
+	g = isl_tarjan_graph_alloc(ctx, len);
+	if (!g)
+		return NULL;
+	for (i = len - 1; i >= 0; --i) {
+		if (g->node[i].index >= 0)
+			continue;
+		isl_tarjan_components_csr(g, i, start, follows);
+	}
+
+	return g;
+}
+
 /* Decompose the graph with "len" nodes and edges defined by "follows"
  * into the strongly connected component (SCC) that contains "node"
  * as well as all SCCs that are followed by this SCC.
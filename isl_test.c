@@ -31,6 +31,7 @@
 #include <isl_factorization.h>
 #include <isl/schedule.h>
 #include <isl/schedule_node.h>
+#include <isl_schedule_private.h>
 #include <isl_options_private.h>
 #include <isl/vertices.h>
 #include <isl/ast_build.h>
@@ -1164,6 +1165,41 @@ static int test_unshifted_simple_hull(isl_ctx *ctx)
 	return 0;
 }
 
+/* Check that isl_set_simple_hull uses the bounding box of
+ * the second basic set to show that the constraint x >= 0
+ * of the first basic set is valid for the second one and
+ * that the result is not affected by this shortcut.
+ */
+static int test_simple_hull_box(isl_ctx *ctx)
+{
+	const char *str;
+	isl_set *set;
+	isl_basic_set *hull, *expected;
+	isl_bool equal;
+	long box;
+
+	str = "{ [x, y] : 0 <= x <= 2 and 0 <= y <= 2; "
+		"[x, y] : 1 <= x <= 3 and y >= 0 and x + y <= 4 }";
+	set = isl_set_read_from_str(ctx, str);
+	expected = isl_basic_set_read_from_str(ctx,
+		"{ [x, y] : 0 <= x <= 3 and 0 <= y <= 3 and x + y <= 4 }");
+	box = ctx->stats->simple_hull_box_bounds;
+	hull = isl_set_simple_hull(set);
+	box = ctx->stats->simple_hull_box_bounds - box;
+	equal = isl_basic_set_is_equal(hull, expected);
+	isl_basic_set_free(hull);
+	isl_basic_set_free(expected);
+	if (equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown, "unexpected hull", return -1);
+	if (box == 0)
+		isl_die(ctx, isl_error_unknown,
+			"bounding box not used", return -1);
+
+	return 0;
+}
+
 static int test_simple_hull(struct isl_ctx *ctx)
 {
 	const char *str;
@@ -1189,6 +1225,8 @@ static int test_simple_hull(struct isl_ctx *ctx)
 		return -1;
 	if (test_unshifted_simple_hull(ctx) < 0)
 		return -1;
+	if (test_simple_hull_box(ctx) < 0)
+		return -1;
 
 	return 0;
 }
@@ -1238,6 +1276,11 @@ struct {
 	    "i2 <= 5 + i0 and i2 >= i0 }" },
 	{ "{ [x, y] : 3y <= 2x and y >= -2 + 2x and 2y >= 2 - x }",
 	    "{ [x, y] : 1 = 0 }" },
+	{ "{ [x, y, z] : 0 <= x, y, z <= 1; "
+	    "[x, y, z] : 2 <= x <= 3 and 1 <= y <= 2 and 1 <= z <= 2 }",
+	  "{ [x, y, z] : 0 <= x <= 3 and 0 <= y <= 2 and 0 <= z <= 2 and "
+	    "-1 + x <= 2y <= 2 + x and -1 + x <= 2z <= 2 + x and "
+	    "-1 + y <= z <= 1 + y }" },
 };
 
 static int test_convex_hull_algo(isl_ctx *ctx, int convex)
@@ -2159,6 +2202,294 @@ static int test_closure(isl_ctx *ctx)
 	return 0;
 }
 
+/* Compute the transitive closure of the map described by "str",
+ * using the closure cache if it is enabled, and
+ * add the number of cache hits to *hits.
+ */
+static __isl_give isl_map *cached_closure(isl_ctx *ctx, const char *str,
+	int *exact, long *hits)
+{
+	isl_map *map;
+	long before;
+
+	before = ctx->stats->closure_cache_hits;
+	map = isl_map_read_from_str(ctx, str);
+	map = isl_map_transitive_closure(map, exact);
+	*hits += ctx->stats->closure_cache_hits - before;
+
+	return map;
+}
+
+/* Check that computing the transitive closure of "str2"
+ * after that of "str1" results in "expected_hits" cache hits and
+ * that the result is the same as that computed without the cache,
+ * with the parameters in the same order.
+ */
+static int test_closure_cache_pair(isl_ctx *ctx, const char *str1,
+	const char *str2, long expected_hits)
+{
+	isl_map *map, *map2;
+	int exact, exact2, equal;
+	long hits = 0;
+
+	map2 = isl_map_read_from_str(ctx, str2);
+	map2 = isl_map_transitive_closure(map2, &exact2);
+
+	isl_options_set_closure_cache_size(ctx, 4);
+	map = cached_closure(ctx, str1, &exact, &hits);
+	isl_map_free(map);
+	hits = 0;
+	map = cached_closure(ctx, str2, &exact, &hits);
+	isl_options_set_closure_cache_size(ctx, 0);
+
+	equal = isl_map_plain_is_equal(map, map2);
+	isl_map_free(map);
+	isl_map_free(map2);
+
+	if (equal < 0)
+		return -1;
+	if (hits != expected_hits)
+		isl_die(ctx, isl_error_unknown,
+			"unexpected number of cache hits", return -1);
+	if (!equal || exact != exact2)
+		isl_die(ctx, isl_error_unknown,
+			"incorrect result", return -1);
+
+	return 0;
+}
+
+/* Closures used in test_closure_cache_evict.
+ */
+static const char *closure_cache_evict_tests[] = {
+	"[n] -> { [i] -> [i + 1] : 0 <= i < n }",
+	"[n] -> { [i] -> [i + 2] : 0 <= i < n }",
+	"[n] -> { [i] -> [i + 3] : 0 <= i < n }",
+	"[n] -> { [i] -> [i + 4] : 0 <= i < n }",
+};
+
+/* Check that lowering the closure_cache_size option evicts
+ * the least recently used entries.
+ * Fill the cache with the first three entries of
+ * closure_cache_evict_tests and then lower the size to 1,
+ * either through isl_options_set_closure_cache_size or
+ * (if "direct" is set) by changing the option directly,
+ * in which case the entries are only evicted when
+ * the next entry (the fourth) is added.
+ * Afterwards, the most recently used entry should still be available,
+ * while the first entry should not.
+ */
+static int test_closure_cache_evict(isl_ctx *ctx, int direct)
+{
+	int i;
+	long hits = 0;
+	isl_map *map;
+	const char **tests = closure_cache_evict_tests;
+
+	isl_options_set_closure_cache_size(ctx, 4);
+	for (i = 0; i < 3; ++i)
+		isl_map_free(cached_closure(ctx, tests[i], NULL, &hits));
+	if (direct) {
+		ctx->opt->closure_cache_size = 1;
+		isl_map_free(cached_closure(ctx, tests[3], NULL, &hits));
+		map = cached_closure(ctx, tests[3], NULL, &hits);
+	} else {
+		isl_options_set_closure_cache_size(ctx, 1);
+		map = cached_closure(ctx, tests[2], NULL, &hits);
+	}
+	isl_map_free(map);
+	if (map)
+		map = cached_closure(ctx, tests[0], NULL, &hits);
+	isl_map_free(map);
+	isl_options_set_closure_cache_size(ctx, 0);
+
+	if (!map)
+		return -1;
+	if (hits != 1)
+		isl_die(ctx, isl_error_unknown,
+			"closure cache not trimmed", return -1);
+
+	return 0;
+}
+
+/* Check that the transitive closure of a map that only differs
+ * from a previously computed one in the order of the parameters
+ * is taken from the closure cache and that the result has
+ * its parameters in the order of the new map, while a map
+ * that differs in the names of the parameters does not reuse
+ * the result.
+ * Also check that the cache does not exceed the closure_cache_size option
+ * after it has been lowered.
+ */
+static int test_closure_cache(isl_ctx *ctx)
+{
+	if (test_closure_cache_pair(ctx,
+		    "[n, m] -> { [i] -> [i + 1] : 0 <= i < n and i < m }",
+		    "[m, n] -> { [i] -> [i + 1] : 0 <= i < n and i < m }",
+		    1) < 0)
+		return -1;
+	if (test_closure_cache_pair(ctx,
+		    "[n] -> { [i] -> [i + 1] : 0 <= i < n }",
+		    "[m] -> { [i] -> [i + 1] : 0 <= i < m }", 0) < 0)
+		return -1;
+	if (test_closure_cache_evict(ctx, 0) < 0)
+		return -1;
+	if (test_closure_cache_evict(ctx, 1) < 0)
+		return -1;
+
+	return 0;
+}
+
+/* Check that a computation is aborted once the deadline has passed
+ * and that computations proceed normally again once the deadline
+ * has been removed.  Also check that isl_ctx_abort aborts
+ * computations until isl_ctx_resume is called.
+ * The loop is bounded such that the test fails rather than hangs
+ * if the deadline is never detected.
+ */
+static int test_deadline(isl_ctx *ctx)
+{
+	int i;
+	int on_error;
+	int aborted, ok;
+	const char *str;
+	isl_set *set;
+
+	str = "{ [i, j] : 0 <= i <= 10 and 0 <= j <= 10 and "
+		"(i <= 5 or j <= 5) }";
+	on_error = isl_options_get_on_error(ctx);
+	isl_options_set_on_error(ctx, ISL_ON_ERROR_CONTINUE);
+	isl_ctx_set_deadline(ctx, 1);
+	for (i = 0; i < 1000000; ++i) {
+		set = isl_set_read_from_str(ctx, str);
+		set = isl_set_coalesce(set);
+		isl_set_free(set);
+		if (!set)
+			break;
+	}
+	aborted = isl_ctx_last_error(ctx) == isl_error_abort;
+	isl_ctx_set_deadline(ctx, 0);
+	isl_ctx_reset_error(ctx);
+	set = isl_set_read_from_str(ctx, str);
+	ok = set != NULL;
+	isl_set_free(set);
+
+	isl_ctx_abort(ctx);
+	set = isl_set_read_from_str(ctx, str);
+	aborted = aborted && !set && isl_ctx_last_error(ctx) == isl_error_abort;
+	isl_set_free(set);
+	isl_ctx_resume(ctx);
+	isl_ctx_reset_error(ctx);
+	isl_options_set_on_error(ctx, on_error);
+
+	if (!aborted)
+		isl_die(ctx, isl_error_unknown, "computation not aborted",
+			return -1);
+	if (!ok)
+		isl_die(ctx, isl_error_unknown, "computation not resumed",
+			return -1);
+
+	return 0;
+}
+
+/* The number of tasks in test_thread_pool.
+ */
+#define N_POOL_TASK	8
+
+/* Data used in the tasks of test_thread_pool.
+ *
+ * "input" contains the input maps, which live in the context
+ * that runs the tasks, and "res" collects the results,
+ * each of which lives in the context of the task that computed it.
+ */
+struct isl_test_thread_pool_data {
+	isl_map *input[N_POOL_TASK];
+	isl_map *res[N_POOL_TASK];
+};
+
+/* Compute the transitive closure of input map "pos" in "ctx".
+ */
+static isl_stat pool_task(isl_ctx *ctx, int pos, void *user)
+{
+	struct isl_test_thread_pool_data *data = user;
+	isl_map *map;
+
+	map = isl_map_transfer(isl_map_copy(data->input[pos]), ctx);
+	data->res[pos] = isl_map_transitive_closure(map, NULL);
+
+	return data->res[pos] ? isl_stat_ok : isl_stat_error;
+}
+
+/* A task of test_thread_pool that aborts the context "user",
+ * which runs the tasks, and that checks that this also aborts
+ * the computation in the context "ctx" of the task.
+ */
+static isl_stat abort_task(isl_ctx *ctx, int pos, void *user)
+{
+	isl_ctx *parent = user;
+
+	isl_ctx_abort(parent);
+	if (isl_ctx_check_interrupt(ctx) >= 0)
+		isl_die(ctx, isl_error_unknown, "task not aborted",
+			return isl_stat_error);
+	isl_ctx_reset_error(ctx);
+
+	return isl_stat_ok;
+}
+
+/* Check that tasks run through isl_ctx_run_tasks on a thread pool
+ * produce the same results as those computed directly,
+ * after transferring them back to "ctx".
+ * If isl was built without thread support, then the tasks are
+ * simply run sequentially.
+ */
+static int test_thread_pool(isl_ctx *ctx)
+{
+	int i;
+	int size;
+	int equal = 1;
+	char buffer[100];
+	struct isl_test_thread_pool_data data;
+	isl_stat r;
+
+	for (i = 0; i < N_POOL_TASK; ++i) {
+		snprintf(buffer, sizeof(buffer),
+			"[n] -> { A[i, j] -> A[i + %d, j + 1] : "
+			"0 <= i, j < n }", i + 1);
+		data.input[i] = isl_map_read_from_str(ctx, buffer);
+		data.res[i] = NULL;
+	}
+
+	size = isl_options_get_thread_pool_size(ctx);
+	isl_options_set_thread_pool_size(ctx, 4);
+	r = isl_ctx_run_tasks(ctx, N_POOL_TASK, &pool_task, &data);
+	if (r >= 0)
+		r = isl_ctx_run_tasks(ctx, N_POOL_TASK, &abort_task, ctx);
+	isl_ctx_resume(ctx);
+	isl_ctx_reset_error(ctx);
+	isl_options_set_thread_pool_size(ctx, size);
+
+	for (i = 0; i < N_POOL_TASK; ++i) {
+		isl_map *res, *expected;
+		int eq;
+
+		res = isl_map_transfer(data.res[i], ctx);
+		expected = isl_map_transitive_closure(data.input[i], NULL);
+		eq = isl_map_is_equal(res, expected);
+		if (eq < 0 || !eq)
+			equal = eq;
+		isl_map_free(res);
+		isl_map_free(expected);
+	}
+
+	if (r < 0 || equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown, "unexpected task result",
+			return -1);
+
+	return 0;
+}
+
 static int test_lex(struct isl_ctx *ctx)
 {
 	isl_space *dim;
@@ -2832,7 +3163,16 @@ static int test_split_periods(isl_ctx *ctx)
 
 static int test_union(isl_ctx *ctx)
 {
+	int i;
 	const char *str;
+	const char *list_str[] = {
+		"[n] -> { A[i] -> B[i] : i < n }",
+		"{ A[i] -> C[i] }",
+		"[m] -> { A[i] -> B[i] : i > m }",
+		"[n] -> { A[i] -> B[i] : i = n }",
+	};
+	isl_map_list *list;
+	isl_space *space;
 	isl_union_set *uset1, *uset2;
 	isl_union_map *umap1, *umap2;
 	int equal;
@@ -2872,6 +3212,146 @@ static int test_union(isl_ctx *ctx)
 		isl_die(ctx, isl_error_unknown, "union sets not equal",
 			return -1);
 
+	umap1 = isl_union_map_empty(isl_space_params_alloc(ctx, 0));
+	list = isl_map_list_alloc(ctx, 4);
+	for (i = 0; i < 4; ++i) {
+		isl_map *map = isl_map_read_from_str(ctx, list_str[i]);
+		umap1 = isl_union_map_add_map(umap1, isl_map_copy(map));
+		list = isl_map_list_add(list, map);
+	}
+	umap2 = isl_union_map_from_map_list(list);
+
+	equal = isl_union_map_is_equal(umap1, umap2);
+
+	isl_union_map_free(umap1);
+	isl_union_map_free(umap2);
+
+	if (equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown, "union maps not equal",
+			return -1);
+
+	str = "[n, m] -> { A[i] -> B[i] : i < n + m }";
+	umap1 = isl_union_map_read_from_str(ctx, str);
+	space = isl_space_params_alloc(ctx, 1);
+	space = isl_space_set_dim_name(space, isl_dim_param, 0, "n");
+	umap2 = isl_union_map_align_params(isl_union_map_copy(umap1), space);
+	equal = umap1 == umap2;
+	isl_union_map_free(umap1);
+	isl_union_map_free(umap2);
+
+	if (!umap2)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown,
+			"trivial alignment should not change union map",
+			return -1);
+
+	str = "[n] -> { A[i] -> B[i]; A[i] -> C[i + n]; [A[i] -> D[]] -> B[i]; "
+		"E[] -> F[] }";
+	umap1 = isl_union_map_read_from_str(ctx, str);
+	str = "[m] -> { B[i] -> G[i + m]; B[i] -> H[]; C[i] -> G[i]; "
+		"[A[i] -> D[]] -> I[i] }";
+	umap2 = isl_union_map_read_from_str(ctx, str);
+	umap1 = isl_union_map_apply_range(umap1, umap2);
+	str = "[n, m] -> { A[i] -> G[i + m]; A[i] -> H[]; A[i] -> G[i + n]; "
+		"[A[i] -> D[]] -> G[i + m]; [A[i] -> D[]] -> H[] }";
+	umap2 = isl_union_map_read_from_str(ctx, str);
+
+	equal = isl_union_map_is_equal(umap1, umap2);
+
+	isl_union_map_free(umap1);
+	isl_union_map_free(umap2);
+
+	if (equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown, "union maps not equal",
+			return -1);
+
+	return 0;
+}
+
+/* Check that isl_id_list_from_names produces the same identifiers
+ * as isl_id_alloc, both for identifiers that already exist and
+ * for those that do not.
+ */
+static int test_id_list(isl_ctx *ctx)
+{
+	int i;
+	int ok = 1;
+	const char *names[] = { "a", "test_id_list_b", "a", "c" };
+	isl_id *a;
+	isl_id_list *list;
+
+	a = isl_id_alloc(ctx, "a", NULL);
+	list = isl_id_list_from_names(ctx, ARRAY_SIZE(names), names);
+	if (!list || isl_id_list_n_id(list) != ARRAY_SIZE(names))
+		ok = 0;
+	for (i = 0; ok && i < ARRAY_SIZE(names); ++i) {
+		isl_id *id, *id2;
+
+		id = isl_id_list_get_id(list, i);
+		id2 = isl_id_alloc(ctx, names[i], NULL);
+		ok = id == id2 && !strcmp(isl_id_get_name(id), names[i]);
+		isl_id_free(id);
+		isl_id_free(id2);
+	}
+	if (ok) {
+		isl_id *id;
+
+		id = isl_id_list_get_id(list, 0);
+		ok = id == a;
+		isl_id_free(id);
+	}
+	isl_id_free(a);
+	isl_id_list_free(list);
+
+	if (!ok)
+		isl_die(ctx, isl_error_unknown, "unexpected identifier list",
+			return -1);
+
+	return 0;
+}
+
+/* Check that a union map can be transferred to another isl_ctx and back
+ * and that the identifiers in the result are those of the target context.
+ */
+static int test_transfer(isl_ctx *ctx)
+{
+	const char *str;
+	isl_ctx *ctx2;
+	isl_id *id, *id2;
+	isl_union_map *umap, *umap2;
+	int equal, same;
+
+	str = "[n] -> { A[i] -> B[[i] -> C[j]] : 0 <= i < n and j > i; "
+		"D[i] -> D[i + 1] : i mod 3 = 0 }";
+	umap = isl_union_map_read_from_str(ctx, str);
+	ctx2 = isl_ctx_alloc();
+	umap2 = isl_union_map_transfer(isl_union_map_copy(umap), ctx2);
+	same = isl_union_map_get_ctx(umap2) == ctx2;
+	id = isl_id_alloc(ctx2, "n", NULL);
+	id2 = isl_union_map_get_dim_id(umap2, isl_dim_param, 0);
+	same = same && id == id2;
+	isl_id_free(id);
+	isl_id_free(id2);
+	umap2 = isl_union_map_transfer(umap2, ctx);
+	equal = isl_union_map_is_equal(umap, umap2);
+	isl_union_map_free(umap);
+	isl_union_map_free(umap2);
+	isl_ctx_free(ctx2);
+
+	if (equal < 0)
+		return -1;
+	if (!same)
+		isl_die(ctx, isl_error_unknown,
+			"transferred object not in target context", return -1);
+	if (!equal)
+		isl_die(ctx, isl_error_unknown, "union maps not equal",
+			return -1);
+
 	return 0;
 }
 
@@ -2988,6 +3468,13 @@ struct {
 			"4e0 >= -61 + i0 + i1)) or "
 		"(i1 <= 66 - i0 and i0 >= 2 and i1 >= 59 + i0) }", 1 },
 	{ "[a, b] -> { : a = 0 and b = -1 }", "[b, a] -> { : b >= -10 }", 1 },
+	{ "{ [i, j] : 0 <= i, j <= 10 }",
+	  "{ [i, j] : exists (e0 = [(i + j)/2]: 2e0 = i + j) or "
+		"(exists (e0 = [(i + j + 1)/2]: 2e0 = i + j + 1 and i < 5)) }",
+	  0 },
+	{ "{ [i, j] : 0 <= i, j <= 10 }",
+	  "{ [i, j] : exists (e0 = [(i + j)/2]: 2e0 = i + j) or "
+		"(exists (e0 = [(i + j + 1)/2]: 2e0 = i + j + 1)) }", 1 },
 };
 
 static int test_subset(isl_ctx *ctx)
@@ -4099,6 +4586,661 @@ static int test_schedule_incremental(isl_ctx *ctx)
 	return r;
 }
 
+/* Schedule constraints for tests that compare the schedules computed
+ * with an option set to different values, consisting of an instance set,
+ * validity constraints and proximity constraints.
+ * If "proximity" is NULL, then the validity constraints
+ * also serve as proximity constraints.
+ */
+struct schedule_toggle_test {
+	const char *domain;
+	const char *validity;
+	const char *proximity;
+};
+
+/* Construct the schedule constraints described by "test".
+ */
+static __isl_give isl_schedule_constraints *toggle_test_constraints(
+	isl_ctx *ctx, struct schedule_toggle_test *test)
+{
+	isl_union_set *dom;
+	isl_union_map *dep;
+	isl_union_map *prox;
+	isl_schedule_constraints *sc;
+
+	dom = isl_union_set_read_from_str(ctx, test->domain);
+	dep = isl_union_map_read_from_str(ctx, test->validity);
+	if (test->proximity)
+		prox = isl_union_map_read_from_str(ctx, test->proximity);
+	else
+		prox = isl_union_map_copy(dep);
+	sc = isl_schedule_constraints_on_domain(dom);
+	sc = isl_schedule_constraints_set_validity(sc, dep);
+	sc = isl_schedule_constraints_set_proximity(sc, prox);
+	return sc;
+}
+
+/* Check that, for each of the "n" inputs in "tests",
+ * the schedule computed with the option set by "set" set to "off"
+ * is the same as the schedule computed with the option set to "on".
+ * "msg" describes the failure if they are not.
+ * The option is left set to "on".
+ */
+static int test_schedule_toggle(isl_ctx *ctx,
+	struct schedule_toggle_test *tests, int n,
+	isl_stat (*set)(isl_ctx *ctx, int val), int off, int on,
+	const char *msg)
+{
+	int i;
+	int equal = 1;
+
+	for (i = 0; equal > 0 && i < n; ++i) {
+		isl_schedule_constraints *sc;
+		isl_schedule *s1, *s2;
+
+		sc = toggle_test_constraints(ctx, &tests[i]);
+		set(ctx, off);
+		s1 = isl_schedule_constraints_compute_schedule(
+					isl_schedule_constraints_copy(sc));
+		set(ctx, on);
+		s2 = isl_schedule_constraints_compute_schedule(sc);
+		equal = isl_schedule_plain_is_equal(s1, s2);
+		isl_schedule_free(s1);
+		isl_schedule_free(s2);
+	}
+
+	if (equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown, msg, return -1);
+
+	return 0;
+}
+
+/* Inputs for test_schedule_concurrent,
+ * each resulting in several independently scheduled components.
+ */
+struct schedule_toggle_test concurrent_schedule_tests[] = {
+	{ "[n] -> { A[i] : 0 <= i < n; B[i, j] : 0 <= i, j < n; "
+		"C[i, j] : 0 <= i, j < n }",
+	  "[n] -> { A[i] -> A[i + 1]; B[i, j] -> B[i + 1, j - 1]; "
+		"C[i, j] -> C[i, j + 1] }",
+	  "[n] -> { B[i, j] -> B[i, j + 1] }" },
+	{ "{ S1[i] : 0 <= i < 10; S2[i] : 0 <= i < 10; "
+		"T1[i, j] : 0 <= i, j < 10; T2[i, j] : 0 <= i, j < 10 }",
+	  "{ S1[i] -> S2[9 - i]; T1[i, j] -> T2[j, i]; "
+		"T2[i, j] -> T2[i + 1, j] }",
+	  "{ S1[i] -> S2[i]; T1[i, j] -> T2[i, j] }" },
+};
+
+/* Check that computing the schedules of independent components
+ * as concurrent tasks results in the same schedules as
+ * computing them one after the other, with and without
+ * the whole component scheduler, and perform the standard
+ * scheduling tests with the schedules of independent components
+ * computed as concurrent tasks.
+ *
+ * Note that the tasks are only run on worker contexts
+ * if isl was built with thread support (ISL_THREAD_POOL).
+ * Otherwise, isl_ctx_run_tasks runs them sequentially in "ctx" and
+ * the transfers to and from the worker contexts are not exercised.
+ */
+static int test_schedule_concurrent(isl_ctx *ctx)
+{
+	int i, whole;
+	int size, concurrent;
+	int r = 0;
+
+	size = isl_options_get_thread_pool_size(ctx);
+	concurrent = isl_options_get_schedule_concurrent_components(ctx);
+	whole = isl_options_get_schedule_whole_component(ctx);
+	isl_options_set_thread_pool_size(ctx, 4);
+	for (i = 0; r >= 0 && i < 2; ++i) {
+		isl_options_set_schedule_whole_component(ctx, i);
+		r = test_schedule_toggle(ctx, concurrent_schedule_tests,
+			    ARRAY_SIZE(concurrent_schedule_tests),
+			    &isl_options_set_schedule_concurrent_components,
+			    0, 1, "concurrent schedule differs from "
+			    "sequential schedule");
+	}
+	isl_options_set_schedule_whole_component(ctx, whole);
+	if (r >= 0)
+		r = test_schedule(ctx);
+	isl_options_set_schedule_concurrent_components(ctx, concurrent);
+	isl_options_set_thread_pool_size(ctx, size);
+
+	return r;
+}
+
+/* Inputs for test_schedule_concurrent_merge,
+ * each resulting in several merge attempts by the incremental scheduler.
+ */
+struct schedule_toggle_test concurrent_merge_tests[] = {
+	{ "{ S[i, j] : 0 <= i, j < 10; T[i, j] : 0 <= i, j < 10; "
+		"U[i, j] : 0 <= i, j < 10; V[i, j] : 0 <= i, j < 10 }",
+	  "{ S[i, j] -> T[i, j]; T[i, j] -> U[j, i]; "
+		"U[i, j] -> V[i, j + 1]; S[i, j] -> V[i, j]; "
+		"T[i, j] -> T[i + 1, j] }" },
+	{ "[n] -> { A[i] : 0 <= i < n; B[i, j] : 0 <= i, j < n; "
+		"C[i, j] : 0 <= i, j < n; D[i] : 0 <= i < n }",
+	  "[n] -> { A[i] -> B[i, j]; B[i, j] -> C[j, i]; "
+		"C[i, j] -> D[i]; B[i, j] -> B[i, j + 1]; "
+		"A[i] -> D[i + 1] }" },
+};
+
+/* Check that scheduling the merge candidates of the incremental scheduler
+ * ahead of time as concurrent tasks results in the same schedules as
+ * scheduling them one at a time, and perform the standard
+ * scheduling tests using the incremental scheduler
+ * with the merge candidates scheduled ahead of time.
+ *
+ * Note that the merge candidates are only scheduled ahead of time
+ * if isl was built with thread support (ISL_THREAD_POOL).
+ * Otherwise, the schedule_concurrent_merge option has no effect and
+ * this test only checks that setting the option does not change
+ * the schedules.
+ */
+static int test_schedule_concurrent_merge(isl_ctx *ctx)
+{
+	int whole;
+	int size, concurrent;
+	int r;
+
+	size = isl_options_get_thread_pool_size(ctx);
+	concurrent = isl_options_get_schedule_concurrent_merge(ctx);
+	whole = isl_options_get_schedule_whole_component(ctx);
+	isl_options_set_thread_pool_size(ctx, 4);
+	isl_options_set_schedule_whole_component(ctx, 0);
+	r = test_schedule_toggle(ctx, concurrent_merge_tests,
+			ARRAY_SIZE(concurrent_merge_tests),
+			&isl_options_set_schedule_concurrent_merge, 0, 1,
+			"concurrent merge schedule differs from "
+			"sequential schedule");
+	if (r >= 0)
+		r = test_schedule(ctx);
+	isl_options_set_schedule_whole_component(ctx, whole);
+	isl_options_set_schedule_concurrent_merge(ctx, concurrent);
+	isl_options_set_thread_pool_size(ctx, size);
+
+	return r;
+}
+
+/* Inputs for test_schedule_budget, consisting of an instance set,
+ * write accesses, read accesses and an original schedule.
+ */
+struct {
+	const char *d;
+	const char *w;
+	const char *r;
+	const char *s;
+} budget_schedule_tests[] = {
+	{ "[N] -> { S1[i] : 1 <= i <= N; S2[i] : 1 <= i <= N; "
+		"S3[i,j] : 1 <= i,j <= N; S4[i] : 1 <= i <= N }",
+	  "{ S1[i] -> a[i,0]; S2[i] -> a[0,i]; S3[i,j] -> a[i,j] }",
+	  "[N] -> { S3[i,j] -> a[i-1,j]; S3[i,j] -> a[i,j-1]; "
+		"S4[i] -> a[i,N] }",
+	  "{ S1[i] -> [0,i,0]; S2[i] -> [1,i,0]; S3[i,j] -> [2,i,j]; "
+		"S4[i] -> [4,i,0] }" },
+	{ "[N] -> { S0[t,i,j] : 0 <= t,i,j < N; S1[t,i,j] : 0 <= t,i,j < N; "
+		"S2[t,i,j] : 0 <= t,i,j < N }",
+	  "{ S0[t,i,j] -> a[t,i,j]; S1[t,i,j] -> b[t,i,j]; "
+		"S2[t,i,j] -> c[t,i,j] }",
+	  "{ S0[t,i,j] -> c[t-1,i,j+1]; S0[t,i,j] -> c[t-1,i-1,j]; "
+		"S1[t,i,j] -> a[t,j,i]; S1[t,i,j] -> b[t,i-1,j+1]; "
+		"S2[t,i,j] -> b[t,i,j-1]; S2[t,i,j] -> a[t,i+1,j] }",
+	  "{ S0[t,i,j] -> [t,0,i,j]; S1[t,i,j] -> [t,1,i,j]; "
+		"S2[t,i,j] -> [t,2,i,j] }" },
+};
+
+/* If "node" is a mark node with identifier "degraded",
+ * then set *found.
+ */
+static isl_bool find_degraded(__isl_keep isl_schedule_node *node, void *user)
+{
+	int *found = user;
+	isl_id *id;
+
+	if (isl_schedule_node_get_type(node) != isl_schedule_node_mark)
+		return isl_bool_true;
+	id = isl_schedule_node_mark_get_id(node);
+	if (!id)
+		return isl_bool_error;
+	if (!strcmp(isl_id_get_name(id), "degraded"))
+		*found = 1;
+	isl_id_free(id);
+
+	return isl_bool_true;
+}
+
+/* Compute a schedule for the instance set "domain" and
+ * validity (and proximity) constraints "validity"
+ * with a deadline that has already passed.
+ * Check that the result is complete, that it respects
+ * the validity constraints and that the scheduler marked
+ * the part of the schedule tree that it constructed
+ * using the fallback algorithm.
+ */
+static int test_expired_budget(isl_ctx *ctx, const char *domain,
+	const char *validity)
+{
+	isl_union_set *dom, *sched_dom;
+	isl_union_map *dep, *map, *lt;
+	isl_schedule_constraints *sc;
+	isl_schedule *schedule;
+	int complete, valid;
+	int found = 0;
+
+	dom = isl_union_set_read_from_str(ctx, domain);
+	dep = isl_union_map_read_from_str(ctx, validity);
+	sc = isl_schedule_constraints_on_domain(isl_union_set_copy(dom));
+	sc = isl_schedule_constraints_set_validity(sc, isl_union_map_copy(dep));
+	sc = isl_schedule_constraints_set_proximity(sc,
+						isl_union_map_copy(dep));
+	schedule = isl_schedule_constraints_compute_schedule_before(sc, 1);
+
+	if (isl_schedule_foreach_schedule_node_top_down(schedule,
+						&find_degraded, &found) < 0)
+		found = -1;
+	map = isl_schedule_get_map(schedule);
+	isl_schedule_free(schedule);
+	sched_dom = isl_union_map_domain(isl_union_map_copy(map));
+	complete = isl_union_set_is_subset(dom, sched_dom);
+	isl_union_set_free(dom);
+	isl_union_set_free(sched_dom);
+	lt = isl_union_map_lex_lt_union_map(isl_union_map_copy(map), map);
+	valid = isl_union_map_is_subset(dep, lt);
+	isl_union_map_free(dep);
+	isl_union_map_free(lt);
+
+	if (found < 0 || complete < 0 || valid < 0)
+		return -1;
+	if (!complete)
+		isl_die(ctx, isl_error_unknown,
+			"schedule incomplete", return -1);
+	if (!valid)
+		isl_die(ctx, isl_error_unknown,
+			"schedule not valid", return -1);
+	if (!found)
+		isl_die(ctx, isl_error_unknown,
+			"missing degraded mark", return -1);
+
+	return 0;
+}
+
+/* A task of test_schedule_budget_abort that aborts the context "user",
+ * which runs the tasks, and then computes a schedule in the context "ctx"
+ * of the task with a deadline that has already passed.
+ * Check that the abort is reported on "ctx" and that the scheduler
+ * fails because of the abort, rather than mistaking it
+ * for an expiry of the budget and falling back
+ * to the degraded algorithm.
+ */
+static isl_stat budget_abort_task(isl_ctx *ctx, int pos, void *user)
+{
+	isl_ctx *parent = user;
+	isl_union_map *dep;
+	isl_schedule_constraints *sc;
+	isl_schedule *schedule;
+	int aborted;
+
+	dep = isl_union_map_read_from_str(ctx,
+		"[N] -> { S[i, j] -> S[i + 1, j - 1] : "
+		"0 <= i < N - 1 and 1 <= j < N }");
+	sc = isl_schedule_constraints_on_domain(isl_union_set_read_from_str(ctx,
+		"[N] -> { S[i, j] : 0 <= i, j < N }"));
+	sc = isl_schedule_constraints_set_validity(sc, isl_union_map_copy(dep));
+	sc = isl_schedule_constraints_set_proximity(sc, dep);
+	if (!sc)
+		return isl_stat_error;
+
+	isl_ctx_abort(parent);
+	aborted = isl_ctx_aborted(ctx);
+	schedule = isl_schedule_constraints_compute_schedule_before(sc, 1);
+	isl_schedule_free(schedule);
+	if (aborted < 0)
+		return isl_stat_error;
+	if (!aborted || schedule || isl_ctx_last_error(ctx) != isl_error_abort)
+		isl_die(ctx, isl_error_unknown,
+			"abort of parent context not detected",
+			return isl_stat_error);
+	isl_ctx_reset_error(ctx);
+
+	return isl_stat_ok;
+}
+
+/* Check that aborting the context that runs tasks also aborts
+ * the computation of a schedule within a budget in a task.
+ * Only a single task is run since any task started
+ * after the abort would fail immediately.
+ * If isl was built without thread support, then the task
+ * runs in "ctx" itself.
+ */
+static int test_schedule_budget_abort(isl_ctx *ctx)
+{
+	int size;
+	isl_stat r;
+
+	size = isl_options_get_thread_pool_size(ctx);
+	isl_options_set_thread_pool_size(ctx, 4);
+	r = isl_ctx_run_tasks(ctx, 1, &budget_abort_task, ctx);
+	isl_ctx_resume(ctx);
+	isl_ctx_reset_error(ctx);
+	isl_options_set_thread_pool_size(ctx, size);
+
+	return r < 0 ? -1 : 0;
+}
+
+/* Check that the scheduler produces a valid and complete schedule
+ * when the schedule_budget option is set to a budget
+ * that expires during (or even before) the computation.
+ * Whether and where the budget expires depends on the speed
+ * of the machine, so the result is not compared
+ * to any specific schedule.
+ * Also check that the fallback is used and marked
+ * when the deadline has already passed before the computation starts,
+ * that it is not used when the computation is aborted instead and
+ * that a budget that does not expire has no effect
+ * on the computed schedule.
+ */
+static int test_schedule_budget(isl_ctx *ctx)
+{
+	int i;
+	int budget;
+	int r = 0;
+
+	if (test_expired_budget(ctx,
+		    "[N] -> { A[i] : 0 <= i < N; B[i] : 0 <= i < N }",
+		    "[N] -> { A[i] -> B[i] : 0 <= i < N; "
+			"B[i] -> A[i + 1] : 0 <= i < N - 1 }") < 0)
+		return -1;
+	if (test_expired_budget(ctx,
+		    "[N] -> { S[i, j] : 0 <= i, j < N }",
+		    "[N] -> { S[i, j] -> S[i + 1, j - 1] : "
+			"0 <= i < N - 1 and 1 <= j < N }") < 0)
+		return -1;
+	if (test_schedule_budget_abort(ctx) < 0)
+		return -1;
+
+	budget = isl_options_get_schedule_budget(ctx);
+	isl_options_set_schedule_budget(ctx, 1);
+	for (i = 0; r >= 0 && i < ARRAY_SIZE(budget_schedule_tests); ++i)
+		r = test_one_schedule(ctx, budget_schedule_tests[i].d,
+				budget_schedule_tests[i].w,
+				budget_schedule_tests[i].r,
+				budget_schedule_tests[i].s, 0, 0);
+	if (r >= 0)
+		r = test_schedule_toggle(ctx, concurrent_schedule_tests, 1,
+				&isl_options_set_schedule_budget, 0, 1000000,
+				"unexpired budget should not affect schedule");
+	isl_options_set_schedule_budget(ctx, budget);
+
+	return r;
+}
+
+/* Recompute a schedule for the instance set "domain" and
+ * validity (and proximity) constraints "validity" starting from
+ * the previous schedule "prev".
+ * Check that the result respects the validity constraints and
+ * that the outermost band of the result, restricted to the instances
+ * in "kept", is equal to "band".
+ */
+static int test_recompute_schedule(isl_ctx *ctx, const char *domain,
+	const char *validity, const char *prev, const char *kept,
+	const char *band)
+{
+	isl_union_map *dep, *map, *lt, *expected;
+	isl_schedule_constraints *sc;
+	isl_schedule *schedule;
+	isl_schedule_node *node;
+	isl_multi_union_pw_aff *mupa;
+	int valid, equal;
+
+	dep = isl_union_map_read_from_str(ctx, validity);
+	sc = isl_schedule_constraints_on_domain(
+				isl_union_set_read_from_str(ctx, domain));
+	sc = isl_schedule_constraints_set_validity(sc, isl_union_map_copy(dep));
+	sc = isl_schedule_constraints_set_proximity(sc,
+						isl_union_map_copy(dep));
+	schedule = isl_schedule_read_from_str(ctx, prev);
+	schedule = isl_schedule_constraints_recompute_schedule(sc, schedule);
+
+	map = isl_schedule_get_map(schedule);
+	lt = isl_union_map_lex_lt_union_map(isl_union_map_copy(map), map);
+	valid = isl_union_map_is_subset(dep, lt);
+	isl_union_map_free(dep);
+	isl_union_map_free(lt);
+
+	node = isl_schedule_get_root(schedule);
+	isl_schedule_free(schedule);
+	node = isl_schedule_node_child(node, 0);
+	mupa = isl_schedule_node_band_get_partial_schedule(node);
+	isl_schedule_node_free(node);
+	map = isl_union_map_from_multi_union_pw_aff(mupa);
+	map = isl_union_map_intersect_domain(map,
+				isl_union_set_read_from_str(ctx, kept));
+	expected = isl_union_map_read_from_str(ctx, band);
+	equal = isl_union_map_is_equal(map, expected);
+	isl_union_map_free(map);
+	isl_union_map_free(expected);
+
+	if (valid < 0 || equal < 0)
+		return -1;
+	if (!valid)
+		isl_die(ctx, isl_error_unknown,
+			"recomputed schedule violates dependences", return -1);
+	if (!equal)
+		isl_die(ctx, isl_error_unknown,
+			"unexpected outermost band", return -1);
+
+	return 0;
+}
+
+/* Check that isl_schedule_constraints_recompute_schedule keeps
+ * the rows of the outermost band of the previous schedule
+ * for statements that appear in the previous schedule,
+ * as long as they are valid.
+ * In the first test, a statement is added and both rows are kept.
+ * In the second test, the second row is no longer valid.
+ * In the third test, the first row is not valid and
+ * so none of the rows can be kept.
+ */
+static int test_schedule_recompute(isl_ctx *ctx)
+{
+	const char *prev;
+
+	prev = "{ domain: \"[n] -> { A[i, j] : 0 <= i, j < n }\", "
+		"child: { schedule: \"[{ A[i, j] -> [(j)] }, "
+		"{ A[i, j] -> [(i)] }]\", permutable: 1 } }";
+	if (test_recompute_schedule(ctx,
+		    "[n] -> { A[i, j] : 0 <= i, j < n; B[i, j] : 0 <= i, j < n }",
+		    "[n] -> { A[i, j] -> A[i + 1, j]; A[i, j] -> B[j, i] }",
+		    prev, "{ A[i, j] }", "{ A[i, j] -> [j, i] }") < 0)
+		return -1;
+	if (test_recompute_schedule(ctx,
+		    "[n] -> { A[i, j] : 0 <= i, j < n }",
+		    "[n] -> { A[i, j] -> A[i - 1, j + 1] }",
+		    prev, "{ A[i, j] }", "{ A[i, j] -> [j, i + j] }") < 0)
+		return -1;
+	if (test_recompute_schedule(ctx,
+		    "[n] -> { A[i, j] : 0 <= i, j < n }",
+		    "[n] -> { A[i, j] -> A[i, j - 1] }",
+		    prev, "{ A[i, j] }", "{ A[i, j] -> [i, -j] }") < 0)
+		return -1;
+
+	return 0;
+}
+
+/* Check that isl_ctx_schedule_stats_to_str reports
+ * statistics about the most recent schedule computation,
+ * including at least one band LP problem.
+ */
+static int test_schedule_stats(isl_ctx *ctx)
+{
+	const char *keys[] = { "total_ms", "graph_init_ms", "duals",
+		"band_lp", "carry_lp", "merge", "pivots", "max_constraints" };
+	isl_union_map *dep;
+	isl_schedule_constraints *sc;
+	isl_schedule *schedule;
+	char *s;
+	int i, ok;
+
+	dep = isl_union_map_read_from_str(ctx,
+		"[n] -> { A[i, j] -> A[i + 1, j]; A[i, j] -> B[j, i] }");
+	sc = isl_schedule_constraints_on_domain(isl_union_set_read_from_str(ctx,
+		"[n] -> { A[i, j] : 0 <= i, j < n; B[i, j] : 0 <= i, j < n }"));
+	sc = isl_schedule_constraints_set_validity(sc, isl_union_map_copy(dep));
+	sc = isl_schedule_constraints_set_proximity(sc, dep);
+	schedule = isl_schedule_constraints_compute_schedule(sc);
+	isl_schedule_free(schedule);
+	if (!schedule)
+		return -1;
+
+	s = isl_ctx_schedule_stats_to_str(ctx);
+	if (!s)
+		return -1;
+	ok = 1;
+	for (i = 0; i < ARRAY_SIZE(keys); ++i)
+		if (!strstr(s, keys[i]))
+			ok = 0;
+	if (strstr(s, "band_lp:\n  count: 0\n"))
+		ok = 0;
+	free(s);
+	if (!ok)
+		isl_die(ctx, isl_error_unknown,
+			"unexpected scheduler statistics", return -1);
+
+	return 0;
+}
+
+/* Inputs for test_schedule_max_generators.
+ * The dependence relations include parametric uniform dependences,
+ * non-uniform dependences, dependences with an unbounded distance and
+ * dependences with a lineality space (in the "j" direction).
+ */
+struct schedule_toggle_test generator_schedule_tests[] = {
+	{ "[n] -> { S[i, j] : 0 <= i, j < n }",
+	  "[n] -> { S[i, j] -> S[i + 1, j - 1]; S[i, j] -> S[i, j + 1] }" },
+	{ "{ A[i, j] : 0 <= i, j < 10; B[i, j] : 0 <= i, j < 10 }",
+	  "{ A[i, j] -> B[j, i]; B[i, j] -> B[i + 1, k] : 0 <= k <= j }" },
+	{ "{ A[i] : i >= 0; B[i] : i >= 0 }",
+	  "{ A[i] -> B[j] : 0 <= i <= j; A[i] -> A[i + 1] : i >= 0 }" },
+	{ "{ A[i, j] : 0 <= i < 10; B[i, j] : 0 <= i < 10 }",
+	  "{ A[i, j] -> A[i + 1, j] : 0 <= i < 9; "
+		"A[i, j] -> B[i, j + 1] : 0 <= i < 10 }" },
+};
+
+/* Check that constructing the duals of the dependence relations
+ * from their generators results in the same schedules as
+ * applying Farkas' lemma, that the statistics report that
+ * the generators were used and perform the standard scheduling tests
+ * with the generators enabled.
+ */
+static int test_schedule_max_generators(isl_ctx *ctx)
+{
+	int max;
+	int r;
+	char *s;
+
+	max = isl_options_get_schedule_max_generators(ctx);
+	r = test_schedule_toggle(ctx, generator_schedule_tests,
+			ARRAY_SIZE(generator_schedule_tests),
+			&isl_options_set_schedule_max_generators, 0, 1000,
+			"schedule computed from generators differs from "
+			"schedule computed using Farkas' lemma");
+	if (r >= 0) {
+		s = isl_ctx_schedule_stats_to_str(ctx);
+		if (!s)
+			r = -1;
+		else if (strstr(s, "generators: 0\n"))
+			isl_die(ctx, isl_error_unknown,
+				"generators not used", r = -1);
+		free(s);
+	}
+	if (r >= 0)
+		r = test_schedule(ctx);
+	isl_options_set_schedule_max_generators(ctx, max);
+
+	return r;
+}
+
+/* Check that reading schedule constraints in which
+ * the value of one of the keys cannot be parsed fails,
+ * rather than silently treating the key as missing.
+ */
+static int test_schedule_constraints_read_fail(isl_ctx *ctx)
+{
+	const char *str;
+	isl_schedule_constraints *sc;
+	int on_error;
+
+	str = "{ domain: \"{ S[i] : 0 <= i < 10 }\", "
+	    "validity: \"{ S[i] -> S[i + }\" }";
+	on_error = isl_options_get_on_error(ctx);
+	isl_options_set_on_error(ctx, ISL_ON_ERROR_CONTINUE);
+	sc = isl_schedule_constraints_read_from_str(ctx, str);
+	isl_options_set_on_error(ctx, on_error);
+	isl_schedule_constraints_free(sc);
+	if (sc)
+		isl_die(ctx, isl_error_unknown,
+			"reading invalid schedule constraints "
+			"not expected to succeed", return -1);
+
+	return 0;
+}
+
+/* Check that schedule constraints can be read in YAML format,
+ * that the constraints that are read in are the expected ones and
+ * that printing and reading them back results in the same output.
+ * Also check that invalid values are rejected.
+ */
+static int test_schedule_constraints_io(isl_ctx *ctx)
+{
+	const char *str;
+	isl_schedule_constraints *sc, *sc2;
+	isl_union_map *umap1, *umap2;
+	char *s1, *s2;
+	isl_bool equal;
+
+	if (test_schedule_constraints_read_fail(ctx) < 0)
+		return -1;
+
+	str = "{ domain: \"[n] -> { S[i] : 0 <= i < n; T[i] : 0 <= i < n }\", "
+	    "context: \"[n] -> { : n >= 2 }\", "
+	    "validity: \"[n] -> { S[i] -> T[i] }\", "
+	    "proximity: \"[n] -> { S[i] -> T[i]; S[i] -> S[i + 1] }\" }";
+	sc = isl_schedule_constraints_read_from_str(ctx, str);
+	umap1 = isl_schedule_constraints_get_proximity(sc);
+	umap2 = isl_union_map_read_from_str(ctx,
+			"[n] -> { S[i] -> T[i]; S[i] -> S[i + 1] }");
+	equal = isl_union_map_is_equal(umap1, umap2);
+	isl_union_map_free(umap1);
+	isl_union_map_free(umap2);
+	if (equal > 0) {
+		umap1 = isl_schedule_constraints_get_coincidence(sc);
+		equal = isl_union_map_is_empty(umap1);
+		isl_union_map_free(umap1);
+	}
+
+	s1 = isl_schedule_constraints_to_str(sc);
+	sc2 = isl_schedule_constraints_read_from_str(ctx, s1);
+	s2 = isl_schedule_constraints_to_str(sc2);
+	isl_schedule_constraints_free(sc);
+	isl_schedule_constraints_free(sc2);
+	if (equal > 0 && (!s1 || !s2))
+		equal = isl_bool_error;
+	if (equal > 0 && (strcmp(s1, s2) || !strstr(s1, "context")))
+		equal = isl_bool_false;
+	free(s1);
+	free(s2);
+	if (equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown,
+			"schedule constraints not preserved", return -1);
+
+	return 0;
+}
+
 int test_plain_injective(isl_ctx *ctx, const char *str, int injective)
 {
 	isl_union_map *umap;
@@ -5996,6 +7138,40 @@ static int test_simplify_2(isl_ctx *ctx)
 	return 0;
 }
 
+/* Check that simplifying a basic set that has already been simplified
+ * is skipped, while simplifying it again after it has been prepared
+ * for modification is not.
+ */
+static int test_simplify_3(isl_ctx *ctx)
+{
+	const char *str;
+	isl_basic_set *bset;
+	long skipped;
+	int first, second;
+
+	str = "{ [a, b] : exists e : 2e = a and b >= 0 and a <= 10 }";
+	bset = isl_basic_set_read_from_str(ctx, str);
+	bset = isl_basic_set_simplify(bset);
+	skipped = ctx->stats->simplify_skipped;
+	bset = isl_basic_set_simplify(bset);
+	first = ctx->stats->simplify_skipped - skipped;
+	bset = isl_basic_set_cow(bset);
+	skipped = ctx->stats->simplify_skipped;
+	bset = isl_basic_set_simplify(bset);
+	second = ctx->stats->simplify_skipped - skipped;
+	isl_basic_set_free(bset);
+
+	if (!bset)
+		return -1;
+	if (first != 1)
+		isl_die(ctx, isl_error_unknown,
+			"repeated simplification not skipped", return -1);
+	if (second != 0)
+		isl_die(ctx, isl_error_unknown,
+			"simplification of modified set skipped", return -1);
+	return 0;
+}
+
 /* Some simplification tests.
  */
 static int test_simplify(isl_ctx *ctx)
@@ -6004,6 +7180,8 @@ static int test_simplify(isl_ctx *ctx)
 		return -1;
 	if (test_simplify_2(ctx) < 0)
 		return -1;
+	if (test_simplify_3(ctx) < 0)
+		return -1;
 	return 0;
 }
 
@@ -6247,7 +7425,45 @@ struct {
 	  "{ rat: [i] : FALSE }" },
 };
 
-/* Test the basic functionality of isl_basic_set_coefficients and
+/* Sets for which the construction of the dual from generators
+ * is compared against the one based on Farkas' lemma.
+ */
+const char *generator_tests[] = {
+	"[n] -> { [i, j] : 0 <= i < n and 0 <= j <= i }",
+	"[n] -> { [i, j] : 0 <= i < n and j = i + 1 }",
+	"[n, m] -> { [i, j] : 0 <= i < n and 0 <= j < m and i + j <= 10 }",
+	"{ [i, j] : i >= 0 and j >= 2i }",
+	"{ [i, j] : i >= 0 }",
+	"{ [i, j] : i <= j }",
+	"[n] -> { [i, j] : j = i + n }",
+	"{ [i, j, k] : 0 <= i <= 5 and j >= k }",
+	"{ [i] : 0 <= 3i <= 2 }",
+	"[n] -> { [t, i, t', i'] : 0 <= t < t' < n and i' - 1 <= i <= i' + 1 }",
+};
+
+/* Check that the dual of "bset" constructed from generators
+ * is equal to "dual".
+ */
+static int check_dual_from_generators(isl_ctx *ctx,
+	__isl_keep isl_basic_set *bset, __isl_keep isl_basic_set *dual)
+{
+	int equal;
+	isl_basic_set *gen;
+
+	gen = isl_basic_set_coefficients_from_generators(
+						isl_basic_set_copy(bset));
+	equal = isl_basic_set_is_equal(gen, dual);
+	isl_basic_set_free(gen);
+	if (equal < 0)
+		return -1;
+	if (!equal)
+		isl_die(ctx, isl_error_unknown,
+			"incorrect dual from generators", return -1);
+	return 0;
+}
+
+/* Test the basic functionality of isl_basic_set_coefficients,
+ * isl_basic_set_coefficients_from_generators and
  * isl_basic_set_solutions.
  */
 static int test_dual(isl_ctx *ctx)
@@ -6256,12 +7472,16 @@ static int test_dual(isl_ctx *ctx)
 
 	for (i = 0; i < ARRAY_SIZE(coef_tests); ++i) {
 		int equal;
-		isl_basic_set *bset1, *bset2;
+		isl_basic_set *bset, *bset1, *bset2;
 
-		bset1 = isl_basic_set_read_from_str(ctx, coef_tests[i].set);
+		bset = isl_basic_set_read_from_str(ctx, coef_tests[i].set);
 		bset2 = isl_basic_set_read_from_str(ctx, coef_tests[i].dual);
-		bset1 = isl_basic_set_coefficients(bset1);
+		bset1 = isl_basic_set_coefficients(isl_basic_set_copy(bset));
 		equal = isl_basic_set_is_equal(bset1, bset2);
+		if (equal > 0 &&
+		    check_dual_from_generators(ctx, bset, bset2) < 0)
+			equal = -1;
+		isl_basic_set_free(bset);
 		isl_basic_set_free(bset1);
 		isl_basic_set_free(bset2);
 		if (equal < 0)
@@ -6271,6 +7491,19 @@ static int test_dual(isl_ctx *ctx)
 				"incorrect dual", return -1);
 	}
 
+	for (i = 0; i < ARRAY_SIZE(generator_tests); ++i) {
+		int r;
+		isl_basic_set *bset, *dual;
+
+		bset = isl_basic_set_read_from_str(ctx, generator_tests[i]);
+		dual = isl_basic_set_coefficients(isl_basic_set_copy(bset));
+		r = check_dual_from_generators(ctx, bset, dual);
+		isl_basic_set_free(bset);
+		isl_basic_set_free(dual);
+		if (r < 0)
+			return -1;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(sol_tests); ++i) {
 		int equal;
 		isl_basic_set *bset1, *bset2;
@@ -6486,6 +7719,13 @@ struct {
 	{ "injective", &test_injective },
 	{ "schedule (whole component)", &test_schedule_whole },
 	{ "schedule (incremental)", &test_schedule_incremental },
+	{ "schedule (concurrent components)", &test_schedule_concurrent },
+	{ "schedule (concurrent merge)", &test_schedule_concurrent_merge },
+	{ "schedule (time budget)", &test_schedule_budget },
+	{ "schedule (recompute)", &test_schedule_recompute },
+	{ "schedule (statistics)", &test_schedule_stats },
+	{ "schedule (generators)", &test_schedule_max_generators },
+	{ "schedule constraints input/output", &test_schedule_constraints_io },
 	{ "schedule tree grouping", &test_schedule_tree_group },
 	{ "tile", &test_tile },
 	{ "union_pw", &test_union_pw },
@@ -6506,6 +7746,8 @@ struct {
 	{ "lift", &test_lift },
 	{ "bound", &test_bound },
 	{ "union", &test_union },
+	{ "transfer", &test_transfer },
+	{ "id list", &test_id_list },
 	{ "split periods", &test_split_periods },
 	{ "lexicographic order", &test_lex },
 	{ "bijectivity", &test_bijective },
@@ -6517,6 +7759,9 @@ struct {
 	{ "map application", &test_application },
 	{ "convex hull", &test_convex_hull },
 	{ "transitive closure", &test_closure },
+	{ "closure cache", &test_closure_cache },
+	{ "deadline", &test_deadline },
+	{ "thread pool", &test_thread_pool },
 };
 
 int main(int argc, char **argv)
@@ -0,0 +1,366 @@
+/*
+ * Use of this software is governed by the MIT license
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <isl_config.h>
+#ifdef ISL_THREAD_POOL
+#include <pthread.h>
+#endif
+#include <isl_ctx_private.h>
+#include <isl_options_private.h>
+#include <isl_thread_pool.h>
+
+/* Call "fn" on each position in [0, n) in order, passing it "ctx" itself,
+ * stopping at the first failure.
+ */
+static isl_stat run_sequentially(isl_ctx *ctx, int n,
+	isl_stat (*fn)(isl_ctx *ctx, int pos, void *user), void *user)
+{
+	int i;
+
+	for (i = 0; i < n; ++i)
+		if (fn(ctx, i, user) < 0)
+			return isl_stat_error;
+
+	return isl_stat_ok;
+}
+
+#ifdef ISL_THREAD_POOL
+
+/* A worker of an isl_thread_pool.
+ *
+ * "ctx" is the context in which the worker runs its tasks.
+ * It has a copy of the options of the context that owns the pool and
+ * is only ever accessed by "thread", except while the pool is idle.
+ */
+struct isl_thread_pool_worker {
+	struct isl_thread_pool *pool;
+	pthread_t thread;
+	isl_ctx *ctx;
+};
+
+/* A pool of "n" threads for running the tasks of isl_ctx_run_tasks.
+ *
+ * "lock" protects all fields below it.
+ * "work" is signaled when tasks become available or
+ * when "shutdown" gets set and "done" is signaled when
+ * the last task of the current batch has finished.
+ *
+ * The current batch consists of calling "fn" on each position
+ * in [0, n_task), passing it "user".
+ * "next" is the next position that still needs to be claimed
+ * by a worker and "running" is the number of tasks that
+ * have been claimed but that have not finished yet.
+ * "failed_pos" is the smallest position of a task that failed
+ * in the current batch or -1 if no task failed and
+ * "error" is the error of the corresponding worker context.
+ */
+struct isl_thread_pool {
+	int n;
+	struct isl_thread_pool_worker *worker;
+
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t done;
+	int shutdown;
+
+	isl_stat (*fn)(isl_ctx *ctx, int pos, void *user);
+	void *user;
+	int n_task;
+	int next;
+	int running;
+	int failed_pos;
+	enum isl_error error;
+};
+
+/* Record that the task at position "pos" of the current batch of "pool"
+ * failed in worker context "ctx" and make sure no further tasks
+ * of this batch get started.
+ * The error of the task with the smallest position is kept
+ * such that the reported error does not depend on the scheduling
+ * of the tasks.
+ */
+static void record_failure(struct isl_thread_pool *pool, isl_ctx *ctx,
+	int pos)
+{
+	if (pool->failed_pos < 0 || pos < pool->failed_pos) {
+		pool->failed_pos = pos;
+		pool->error = isl_ctx_last_error(ctx);
+		if (pool->error == isl_error_none)
+			pool->error = isl_error_unknown;
+	}
+	pool->next = pool->n_task;
+}
+
+/* The main function of a worker thread.
+ * Repeatedly claim the next task of the current batch and run it
+ * in the context of the worker, until the pool is shut down.
+ */
+static void *worker_main(void *arg)
+{
+	struct isl_thread_pool_worker *worker = arg;
+	struct isl_thread_pool *pool = worker->pool;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;) {
+		int pos;
+		isl_stat r;
+
+		while (!pool->shutdown && pool->next >= pool->n_task)
+			pthread_cond_wait(&pool->work, &pool->lock);
+		if (pool->shutdown)
+			break;
+		pos = pool->next++;
+		pool->running++;
+		pthread_mutex_unlock(&pool->lock);
+
+		r = pool->fn(worker->ctx, pos, pool->user);
+
+		pthread_mutex_lock(&pool->lock);
+		if (r < 0)
+			record_failure(pool, worker->ctx, pos);
+		pool->running--;
+		if (pool->running == 0 && pool->next >= pool->n_task)
+			pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+/* Stop the threads of "pool" and free all associated memory,
+ * including the worker contexts.
+ */
+void isl_thread_pool_free(struct isl_thread_pool *pool)
+{
+	int i;
+
+	if (!pool)
+		return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->shutdown = 1;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (i = 0; i < pool->n; ++i)
+		pthread_join(pool->worker[i].thread, NULL);
+	for (i = 0; i < pool->n; ++i)
+		isl_ctx_free(pool->worker[i].ctx);
+
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->work);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->worker);
+	free(pool);
+}
+
+/* Allocate a context for a worker of a thread pool owned by "ctx".
+ * The options of "ctx" are copied, except that the worker context
+ * does not get a thread pool of its own.
+ * The worker context also checks the abort flag of "ctx"
+ * such that isl_ctx_abort on "ctx" aborts the running tasks.
+ */
+static isl_ctx *alloc_worker_ctx(isl_ctx *ctx)
+{
+	struct isl_options *opt;
+	isl_ctx *worker_ctx;
+
+	opt = isl_options_dup(ctx->opt);
+	if (!opt)
+		return NULL;
+	opt->thread_pool_size = 0;
+	worker_ctx = isl_ctx_alloc_with_options(&isl_options_args, opt);
+	if (worker_ctx)
+		worker_ctx->parent_abort = &ctx->abort;
+	return worker_ctx;
+}
+
+/* Replace the options of the worker context "worker_ctx" by
+ * a copy of the current options of "ctx", except that
+ * the worker context still does not get a thread pool of its own.
+ * This ensures that options changed after the creation of the pool
+ * also apply to the tasks.
+ */
+static isl_stat update_worker_options(isl_ctx *worker_ctx, isl_ctx *ctx)
+{
+	struct isl_options *opt = worker_ctx->opt;
+	char *type = NULL;
+
+	if (ctx->opt->ast_iterator_type) {
+		type = strdup(ctx->opt->ast_iterator_type);
+		if (!type)
+			isl_die(ctx, isl_error_unknown, "out of memory",
+				return isl_stat_error);
+	}
+	free(opt->ast_iterator_type);
+	*opt = *ctx->opt;
+	opt->ast_iterator_type = type;
+	opt->thread_pool_size = 0;
+
+	return isl_stat_ok;
+}
+
+/* Create a pool of "n" threads for "ctx", each with its own context.
+ */
+static struct isl_thread_pool *thread_pool_alloc(isl_ctx *ctx, int n)
+{
+	int i;
+	struct isl_thread_pool *pool;
+
+	pool = isl_calloc_type(ctx, struct isl_thread_pool);
+	if (!pool)
+		return NULL;
+	pool->worker = isl_calloc_array(ctx, struct isl_thread_pool_worker, n);
+	if (!pool->worker) {
+		free(pool);
+		return NULL;
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work, NULL);
+	pthread_cond_init(&pool->done, NULL);
+
+	for (i = 0; i < n; ++i) {
+		struct isl_thread_pool_worker *worker = &pool->worker[i];
+
+		worker->pool = pool;
+		worker->ctx = alloc_worker_ctx(ctx);
+		if (!worker->ctx)
+			break;
+		if (pthread_create(&worker->thread, NULL,
+				    &worker_main, worker) != 0) {
+			isl_ctx_free(worker->ctx);
+			break;
+		}
+		pool->n++;
+	}
+	if (pool->n < n) {
+		isl_thread_pool_free(pool);
+		isl_die(ctx, isl_error_unknown,
+			"unable to start thread pool", return NULL);
+	}
+
+	return pool;
+}
+
+/* Return the thread pool of "ctx", creating it if needed.
+ */
+static struct isl_thread_pool *get_thread_pool(isl_ctx *ctx)
+{
+	if (!ctx->thread_pool)
+		ctx->thread_pool = thread_pool_alloc(ctx,
+						ctx->opt->thread_pool_size);
+	return ctx->thread_pool;
+}
+
+/* Run the tasks of isl_ctx_run_tasks on the thread pool of "ctx".
+ *
+ * While the workers are idle, the parent thread prepares
+ * their contexts for the new batch by clearing any error
+ * from a previous batch and by passing along the options and
+ * the deadline of "ctx".
+ * An abort of "ctx" does not need to be passed along since
+ * the worker contexts check the abort flag of "ctx" directly.
+ * It then waits for all tasks to finish and reports the error
+ * of the failed task with the smallest position, if any, on "ctx".
+ */
+static isl_stat run_on_pool(isl_ctx *ctx, int n,
+	isl_stat (*fn)(isl_ctx *ctx, int pos, void *user), void *user)
+{
+	int i;
+	int failed;
+	struct isl_thread_pool *pool;
+
+	pool = get_thread_pool(ctx);
+	if (!pool)
+		return isl_stat_error;
+
+	pthread_mutex_lock(&pool->lock);
+	for (i = 0; i < pool->n; ++i) {
+		if (update_worker_options(pool->worker[i].ctx, ctx) < 0)
+			break;
+		isl_ctx_reset_error(pool->worker[i].ctx);
+		pool->worker[i].ctx->deadline = ctx->deadline;
+	}
+	if (i < pool->n) {
+		pthread_mutex_unlock(&pool->lock);
+		return isl_stat_error;
+	}
+	pool->fn = fn;
+	pool->user = user;
+	pool->n_task = n;
+	pool->next = 0;
+	pool->failed_pos = -1;
+	pthread_cond_broadcast(&pool->work);
+	while (pool->running > 0 || pool->next < pool->n_task)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	failed = pool->failed_pos >= 0;
+	pthread_mutex_unlock(&pool->lock);
+
+	if (failed) {
+		isl_ctx_set_error(ctx, pool->error);
+		return isl_stat_error;
+	}
+	return isl_stat_ok;
+}
+
+#else
+
+void isl_thread_pool_free(struct isl_thread_pool *pool)
+{
+}
+
+/* Without thread support, the tasks are simply run sequentially.
+ */
+static isl_stat run_on_pool(isl_ctx *ctx, int n,
+	isl_stat (*fn)(isl_ctx *ctx, int pos, void *user), void *user)
+{
+	return run_sequentially(ctx, n, fn, user);
+}
+
+#endif
+
+/* Would isl_ctx_run_tasks on "ctx" run the tasks concurrently?
+ * That is, was isl built with thread support and
+ * is the thread_pool_size option greater than one?
+ */
+int isl_ctx_runs_tasks_concurrently(isl_ctx *ctx)
+{
+#ifdef ISL_THREAD_POOL
+	return ctx && ctx->opt->thread_pool_size > 1;
+#else
+	return 0;
+#endif
+}
+
+/* Call "fn" on each position in [0, n), passing it "user" and
+ * a context in which all objects created by the task should live.
+ *
+ * If the thread_pool_size option is greater than one and
+ * isl was built with thread support, then the tasks are run
+ * on a pool of that many threads owned by "ctx", each with
+ * a context of its own that is passed to "fn".
+ * Otherwise, the tasks are run sequentially in order of their position,
+ * in "ctx" itself.
+ * In both cases, "fn" should store its result at a location
+ * determined by "pos", such that the results can be collected
+ * in a fixed order once all tasks have finished.
+ */
+isl_stat isl_ctx_run_tasks(isl_ctx *ctx, int n,
+	isl_stat (*fn)(isl_ctx *ctx, int pos, void *user), void *user)
+{
+	if (!ctx || !fn)
+		return isl_stat_error;
+	if (n < 0)
+		isl_die(ctx, isl_error_invalid, "negative number of tasks",
+			return isl_stat_error);
+	if (n == 0)
+		return isl_stat_ok;
+	if (isl_ctx_check_interrupt(ctx) < 0)
+		return isl_stat_error;
+	if (!isl_ctx_runs_tasks_concurrently(ctx))
+		return run_sequentially(ctx, n, fn, user);
+	return run_on_pool(ctx, n, fn, user);
+}
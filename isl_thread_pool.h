@@ -0,0 +1,11 @@
+#ifndef ISL_THREAD_POOL_H
+#define ISL_THREAD_POOL_H
+
+#include <isl/ctx.h>
+
+struct isl_thread_pool;
+
+void isl_thread_pool_free(struct isl_thread_pool *pool);
+int isl_ctx_runs_tasks_concurrently(isl_ctx *ctx);
+
+#endif
@@ -19,6 +19,7 @@
 #include <isl_vec_private.h>
 #include <isl_options_private.h>
 #include <isl_tarjan.h>
+#include <isl_closure_cache.h>
 
 int isl_map_is_transitively_closed(__isl_keep isl_map *map)
 {
@@ -2022,7 +2023,7 @@ error:
  * and made positive.  The extra coordinates are subsequently projected out
  * and the parameter is turned into the domain of the result.
  */
-__isl_give isl_map *isl_map_power(__isl_take isl_map *map, int *exact)
+static __isl_give isl_map *compute_power(__isl_take isl_map *map, int *exact)
 {
 	isl_space *target_dim;
 	isl_space *dim;
@@ -2067,6 +2068,51 @@ __isl_give isl_map *isl_map_power(__isl_take isl_map *map, int *exact)
 	return map;
 }
 
+/* Apply "fn" to "map", reusing a previous result from the closure cache
+ * of the context, if any, and storing the result in the cache otherwise.
+ * "op" identifies the operation performed by "fn".
+ * Whether or not the caller is interested in exactness information
+ * (i.e., whether "exact" is NULL) is passed along to "fn" and
+ * is therefore also taken into account in the cache lookup.
+ */
+static __isl_give isl_map *cached(__isl_take isl_map *map, int *exact,
+	enum isl_closure_cache_op op,
+	__isl_give isl_map *(*fn)(__isl_take isl_map *map, int *exact))
+{
+	isl_bool found;
+	isl_map *res;
+	int res_exact = 0;
+
+	found = isl_closure_cache_find(map, op, exact != NULL, &res, exact);
+	if (found < 0)
+		goto error;
+	if (found) {
+		isl_map_free(map);
+		return res;
+	}
+
+	res = fn(isl_map_copy(map), exact ? &res_exact : NULL);
+	if (exact)
+		*exact = res_exact;
+	if (res &&
+	    isl_closure_cache_add(map, op, exact != NULL, res, res_exact) < 0)
+		res = isl_map_free(res);
+
+	isl_map_free(map);
+	return res;
+error:
+	isl_map_free(map);
+	return NULL;
+}
+
+/* Compute the positive powers of "map", or an overapproximation,
+ * using the closure cache if it is enabled.
+ */
+__isl_give isl_map *isl_map_power(__isl_take isl_map *map, int *exact)
+{
+	return cached(map, exact, isl_closure_cache_power, &compute_power);
+}
+
 /* Compute a relation that maps each element in the range of the input
  * relation to the lengths of all paths composed of edges in the input
  * relation that end up in the given range element.
@@ -2578,8 +2624,8 @@ error:
  * it to project out the lengths of the paths instead of equating
  * the length to a parameter.
  */
-__isl_give isl_map *isl_map_transitive_closure(__isl_take isl_map *map,
-	int *exact)
+static __isl_give isl_map *compute_transitive_closure(
+	__isl_take isl_map *map, int *exact)
 {
 	isl_space *target_dim;
 	int closed;
@@ -2611,6 +2657,16 @@ error:
 	return NULL;
 }
 
+/* Compute the transitive closure of "map", or an overapproximation,
+ * using the closure cache if it is enabled.
+ */
+__isl_give isl_map *isl_map_transitive_closure(__isl_take isl_map *map,
+	int *exact)
+{
+	return cached(map, exact, isl_closure_cache_transitive_closure,
+			&compute_transitive_closure);
+}
+
 static isl_stat inc_count(__isl_take isl_map *map, void *user)
 {
 	int *n = user;
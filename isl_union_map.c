@@ -22,6 +22,7 @@
 #include <isl/map.h>
 #include <isl/set.h>
 #include <isl_space_private.h>
+#include <isl_refcount.h>
 #include <isl/union_set.h>
 #include <isl/deprecated/union_map_int.h>
 
@@ -182,15 +183,22 @@ error:
 	return NULL;
 }
 
+/* Return a version of "umap" that can be modified.
+ * If "umap" is shared, then the duplicate is constructed before
+ * the reference to "umap" is released.
+ */
 __isl_give isl_union_map *isl_union_map_cow(__isl_take isl_union_map *umap)
 {
+	isl_union_map *dup;
+
 	if (!umap)
 		return NULL;
 
-	if (umap->ref == 1)
+	if (isl_refcount_get(umap->ref) == 1)
 		return umap;
-	umap->ref--;
-	return isl_union_map_dup(umap);
+	dup = isl_union_map_dup(umap);
+	isl_union_map_free(umap);
+	return dup;
 }
 
 struct isl_union_align {
@@ -217,10 +225,16 @@ static isl_stat align_entry(void **entry, void *user)
  * The result has the parameters of model first, in the same order
  * as they appear in model, followed by any remaining parameters of
  * umap that do not appear in model.
+ *
+ * If the parameters of model already appear in this order
+ * at the start of those of umap, then the alignment
+ * does not change anything and umap is returned directly
+ * rather than rebuilding each of its maps.
  */
 __isl_give isl_union_map *isl_union_map_align_params(
 	__isl_take isl_union_map *umap, __isl_take isl_space *model)
 {
+	isl_bool identity;
 	struct isl_union_align data = { NULL, NULL };
 
 	if (!umap || !model)
@@ -233,8 +247,14 @@ __isl_give isl_union_map *isl_union_map_align_params(
 
 	model = isl_space_params(model);
 	data.exp = isl_parameter_alignment_reordering(umap->dim, model);
-	if (!data.exp)
+	identity = isl_reordering_is_identity(data.exp);
+	if (identity < 0)
 		goto error;
+	if (identity) {
+		isl_reordering_free(data.exp);
+		isl_space_free(model);
+		return umap;
+	}
 
 	data.res = isl_union_map_alloc(isl_space_copy(data.exp->dim),
 					umap->table.n);
@@ -294,7 +314,7 @@ __isl_give isl_union_map *isl_union_map_copy(__isl_keep isl_union_map *umap)
 	if (!umap)
 		return NULL;
 
-	umap->ref++;
+	isl_refcount_inc(umap->ref);
 	return umap;
 }
 
@@ -308,7 +328,7 @@ __isl_null isl_union_map *isl_union_map_free(__isl_take isl_union_map *umap)
 	if (!umap)
 		return NULL;
 
-	if (--umap->ref > 0)
+	if (isl_refcount_dec(umap->ref) > 0)
 		return NULL;
 
 	isl_hash_table_foreach(umap->dim->ctx, &umap->table,
@@ -324,6 +344,62 @@ __isl_null isl_union_set *isl_union_set_free(__isl_take isl_union_set *uset)
 	return isl_union_map_free(uset);
 }
 
+/* Data structure for isl_union_map_transfer.
+ *
+ * "ctx" is the target context and "res" collects the transferred maps.
+ */
+struct isl_union_map_transfer_data {
+	isl_ctx *ctx;
+	isl_union_map *res;
+};
+
+/* Transfer "map" to data->ctx and add it to data->res.
+ */
+static isl_stat transfer_entry(void **entry, void *user)
+{
+	struct isl_union_map_transfer_data *data = user;
+	isl_map *map = *entry;
+
+	map = isl_map_transfer(isl_map_copy(map), data->ctx);
+	data->res = isl_union_map_add_map(data->res, map);
+
+	return data->res ? isl_stat_ok : isl_stat_error;
+}
+
+/* Return a copy of "umap" that lives in "ctx".
+ * Each of the maps is transferred using isl_map_transfer.
+ * Since all parameter identifiers are remapped through
+ * the identifier table of "ctx", the transferred maps
+ * have the same parameters as the transferred space of "umap".
+ * If "umap" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_union_map *isl_union_map_transfer(
+	__isl_take isl_union_map *umap, isl_ctx *ctx)
+{
+	isl_space *space;
+	struct isl_union_map_transfer_data data = { ctx };
+
+	if (!umap || !ctx)
+		return isl_union_map_free(umap);
+	if (umap->dim->ctx == ctx)
+		return umap;
+
+	space = isl_space_transfer(isl_space_copy(umap->dim), ctx);
+	data.res = isl_union_map_alloc(space, umap->table.n);
+	if (isl_hash_table_foreach(umap->dim->ctx, &umap->table,
+				   &transfer_entry, &data) < 0)
+		data.res = isl_union_map_free(data.res);
+
+	isl_union_map_free(umap);
+	return data.res;
+}
+
+__isl_give isl_union_set *isl_union_set_transfer(
+	__isl_take isl_union_set *uset, isl_ctx *ctx)
+{
+	return isl_union_map_transfer(uset, ctx);
+}
+
 static int has_dim(const void *entry, const void *val)
 {
 	isl_map *map = (isl_map *)entry;
@@ -417,6 +493,130 @@ __isl_give isl_union_set *isl_union_set_from_basic_set(
 	return isl_union_map_from_basic_map(bset);
 }
 
+/* Return the parameter space of the elements of "list",
+ * with the parameters of all elements combined.
+ */
+static __isl_give isl_space *map_list_params(__isl_keep isl_map_list *list)
+{
+	int i, n;
+	isl_space *space;
+
+	n = isl_map_list_n_map(list);
+	space = isl_space_params_alloc(isl_map_list_get_ctx(list), 0);
+	for (i = 0; i < n; ++i) {
+		isl_map *map;
+
+		map = isl_map_list_get_map(list, i);
+		if (!map)
+			return isl_space_free(space);
+		if (!isl_space_match(map->dim, isl_dim_param,
+					space, isl_dim_param))
+			space = isl_space_align_params(space,
+							isl_map_get_space(map));
+		isl_map_free(map);
+	}
+
+	return space;
+}
+
+/* Add the basic maps of "map" to the map in "entry",
+ * which lives in the same space.
+ * The map in "entry" is grown geometrically such that adding
+ * many maps to the same entry does not take quadratic time.
+ */
+static isl_stat merge_into_entry(struct isl_hash_table_entry *entry,
+	__isl_take isl_map *map)
+{
+	int i;
+	isl_map *res = entry->data;
+
+	entry->data = NULL;
+	res = isl_map_cow(res);
+	if (res && map && res->n + map->n > res->size)
+		res = isl_map_grow(res, res->n + map->n);
+	for (i = 0; res && map && i < map->n; ++i)
+		res = isl_map_add_basic_map(res, isl_basic_map_copy(map->p[i]));
+	if (res && res->n > 1)
+		ISL_F_CLR(res, ISL_MAP_DISJOINT);
+	isl_map_free(map);
+
+	entry->data = res;
+	return res ? isl_stat_ok : isl_stat_error;
+}
+
+/* Construct a union map containing the union of the elements of "list".
+ *
+ * The result contains the same elements as the result of adding
+ * the elements one by one using isl_union_map_add_map, but
+ * the parameters are only aligned once, to the combined parameters
+ * of all elements, the hash table is allocated with the appropriate size
+ * up front and elements living in the same space are combined
+ * by collecting all their basic maps in a single map rather than
+ * by repeatedly computing a pairwise union.
+ * In particular, unlike isl_map_union, this does not remove
+ * duplicate basic maps, so the representation may differ.
+ */
+__isl_give isl_union_map *isl_union_map_from_map_list(
+	__isl_take isl_map_list *list)
+{
+	int i, n;
+	isl_ctx *ctx;
+	isl_space *space;
+	isl_union_map *umap;
+
+	if (!list)
+		return NULL;
+
+	ctx = isl_map_list_get_ctx(list);
+	n = isl_map_list_n_map(list);
+	space = map_list_params(list);
+	umap = isl_union_map_alloc(space, n);
+	if (!umap)
+		goto error;
+
+	for (i = 0; i < n; ++i) {
+		isl_map *map;
+		uint32_t hash;
+		struct isl_hash_table_entry *entry;
+
+		map = isl_map_list_get_map(list, i);
+		map = isl_map_align_params(map, isl_space_copy(umap->dim));
+		if (!map)
+			goto error;
+		if (isl_map_plain_is_empty(map)) {
+			isl_map_free(map);
+			continue;
+		}
+
+		hash = isl_space_get_hash(map->dim);
+		entry = isl_hash_table_find(ctx, &umap->table, hash,
+					    &has_dim, map->dim, 1);
+		if (!entry) {
+			isl_map_free(map);
+			goto error;
+		}
+		if (!entry->data)
+			entry->data = map;
+		else if (merge_into_entry(entry, map) < 0)
+			goto error;
+	}
+
+	isl_map_list_free(list);
+	return umap;
+error:
+	isl_map_list_free(list);
+	isl_union_map_free(umap);
+	return NULL;
+}
+
+/* Construct a union set containing the union of the elements of "list".
+ */
+__isl_give isl_union_set *isl_union_set_from_set_list(
+	__isl_take isl_set_list *list)
+{
+	return isl_union_map_from_map_list((isl_map_list *) list);
+}
+
 struct isl_union_map_foreach_data
 {
 	isl_stat (*fn)(__isl_take isl_map *map, void *user);
@@ -1217,8 +1417,34 @@ __isl_give isl_union_map *isl_union_map_intersect_range(
 	return gen_bin_op(umap, uset, &intersect_range_entry);
 }
 
+/* A group of maps in a union map that share the same tuple
+ * of a given type, represented by the set space "space".
+ * The "n" maps are stored in "map", which has room for "size" elements.
+ * The maps are not owned by the group.
+ */
+struct isl_union_map_group {
+	isl_space *space;
+	int n;
+	int size;
+	isl_map **map;
+};
+
+/* Data structure for match_tuple_bin_op.
+ *
+ * "umap2" is the second argument of the operation.
+ * If "index" is not NULL, then it groups the maps in "umap2"
+ * by their tuple of type "type2" and "fn" only needs to be applied
+ * to pairs of maps where the tuple of type "type1" of the first map
+ * is equal to this tuple of the second.
+ * Otherwise, "fn" is applied to all pairs.
+ * "map" is the current map of the first argument and
+ * "res" collects the results.
+ */
 struct isl_union_map_bin_data {
 	isl_union_map *umap2;
+	struct isl_hash_table *index;
+	enum isl_dim_type type1;
+	enum isl_dim_type type2;
 	isl_union_map *res;
 	isl_map *map;
 	isl_stat (*fn)(void **entry, void *user);
@@ -1251,12 +1477,162 @@ static isl_stat apply_range_entry(void **entry, void *user)
 	return isl_stat_ok;
 }
 
+/* Return the tuple of type "type" of "map" as a set space.
+ */
+static __isl_give isl_space *map_tuple_space(__isl_keep isl_map *map,
+	enum isl_dim_type type)
+{
+	isl_space *space;
+
+	space = isl_map_get_space(map);
+	if (type == isl_dim_in)
+		return isl_space_domain(space);
+	return isl_space_range(space);
+}
+
+static int has_group_space(const void *entry, const void *val)
+{
+	const struct isl_union_map_group *group = entry;
+	isl_space *space = (isl_space *) val;
+
+	return isl_space_is_equal(group->space, space);
+}
+
+static isl_stat free_group(void **entry, void *user)
+{
+	struct isl_union_map_group *group = *entry;
+
+	isl_space_free(group->space);
+	free(group->map);
+	free(group);
+
+	return isl_stat_ok;
+}
+
+static void free_index(isl_ctx *ctx, struct isl_hash_table *index)
+{
+	if (!index)
+		return;
+	isl_hash_table_foreach(ctx, index, &free_group, NULL);
+	isl_hash_table_free(ctx, index);
+}
+
+/* Return the group of maps in "index" with tuple space "space",
+ * creating an empty group if there is none yet.
+ */
+static struct isl_union_map_group *get_group(isl_ctx *ctx,
+	struct isl_hash_table *index, __isl_take isl_space *space)
+{
+	uint32_t hash;
+	struct isl_hash_table_entry *entry;
+	struct isl_union_map_group *group;
+
+	if (!space)
+		return NULL;
+
+	hash = isl_space_get_hash(space);
+	entry = isl_hash_table_find(ctx, index, hash,
+				    &has_group_space, space, 1);
+	if (!entry)
+		goto error;
+	if (entry->data) {
+		isl_space_free(space);
+		return entry->data;
+	}
+
+	group = isl_calloc_type(ctx, struct isl_union_map_group);
+	entry->data = group;
+	if (!group)
+		goto error;
+	group->space = space;
+	return group;
+error:
+	isl_space_free(space);
+	return NULL;
+}
+
+/* Add the map in "entry" to the group in data->index that corresponds
+ * to its tuple of type data->type2.
+ */
+static isl_stat add_to_index(void **entry, void *user)
+{
+	struct isl_union_map_bin_data *data = user;
+	isl_map *map = *entry;
+	isl_ctx *ctx = isl_map_get_ctx(map);
+	struct isl_union_map_group *group;
+
+	group = get_group(ctx, data->index, map_tuple_space(map, data->type2));
+	if (!group)
+		return isl_stat_error;
+	if (group->n >= group->size) {
+		isl_map **maps;
+		int size = 2 * group->size + 1;
+
+		maps = isl_realloc_array(ctx, group->map, isl_map *, size);
+		if (!maps)
+			return isl_stat_error;
+		group->map = maps;
+		group->size = size;
+	}
+	group->map[group->n++] = map;
+
+	return isl_stat_ok;
+}
+
+/* Group the maps in data->umap2 by their tuple of type data->type2
+ * and store the result in data->index.
+ * Within each group, the maps appear in the order in which
+ * they are visited by isl_hash_table_foreach.
+ */
+static isl_stat build_index(struct isl_union_map_bin_data *data)
+{
+	isl_ctx *ctx = isl_union_map_get_ctx(data->umap2);
+
+	data->index = isl_hash_table_alloc(ctx, data->umap2->table.n);
+	if (!data->index)
+		return isl_stat_error;
+	return isl_hash_table_foreach(ctx, &data->umap2->table,
+				      &add_to_index, data);
+}
+
+/* Apply data->fn to data->map and each map in data->umap2
+ * with a matching tuple, using data->index.
+ */
+static isl_stat indexed_bin_entry(struct isl_union_map_bin_data *data)
+{
+	int i;
+	uint32_t hash;
+	isl_ctx *ctx = isl_map_get_ctx(data->map);
+	isl_space *space;
+	struct isl_hash_table_entry *entry;
+	struct isl_union_map_group *group;
+
+	space = map_tuple_space(data->map, data->type1);
+	if (!space)
+		return isl_stat_error;
+	hash = isl_space_get_hash(space);
+	entry = isl_hash_table_find(ctx, data->index, hash,
+				    &has_group_space, space, 0);
+	isl_space_free(space);
+	if (!entry)
+		return isl_stat_ok;
+
+	group = entry->data;
+	for (i = 0; i < group->n; ++i)
+		if (data->fn((void **) &group->map[i], data) < 0)
+			return isl_stat_error;
+
+	return isl_stat_ok;
+}
+
 static isl_stat bin_entry(void **entry, void *user)
 {
 	struct isl_union_map_bin_data *data = user;
 	isl_map *map = *entry;
 
 	data->map = map;
+	if (data->index)
+		return indexed_bin_entry(data);
 	if (isl_hash_table_foreach(data->umap2->dim->ctx, &data->umap2->table,
 				   data->fn, data) < 0)
 		return isl_stat_error;
@@ -1264,11 +1640,22 @@ static isl_stat bin_entry(void **entry, void *user)
 	return isl_stat_ok;
 }
 
-static __isl_give isl_union_map *bin_op(__isl_take isl_union_map *umap1,
-	__isl_take isl_union_map *umap2,
+/* Apply "fn" to pairs of maps from "umap1" and "umap2" and
+ * collect the results.
+ * If "match" is set, then "fn" only needs to be applied to pairs
+ * where the tuple of type "type1" of the first map is equal
+ * to the tuple of type "type2" of the second map.
+ * In this case, the maps in "umap2" are first grouped by
+ * this tuple such that each map in "umap1" only needs to look
+ * at the matching maps instead of all maps in "umap2".
+ */
+static __isl_give isl_union_map *match_tuple_bin_op(
+	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2,
+	int match, enum isl_dim_type type1, enum isl_dim_type type2,
 	isl_stat (*fn)(void **entry, void *user))
 {
-	struct isl_union_map_bin_data data = { NULL, NULL, NULL, fn };
+	struct isl_union_map_bin_data data = { NULL, NULL, type1, type2,
+						NULL, NULL, fn };
 
 	umap1 = isl_union_map_align_params(umap1, isl_union_map_get_space(umap2));
 	umap2 = isl_union_map_align_params(umap2, isl_union_map_get_space(umap1));
@@ -1277,26 +1664,39 @@ static __isl_give isl_union_map *bin_op(__isl_take isl_union_map *umap1,
 		goto error;
 
 	data.umap2 = umap2;
+	if (match && build_index(&data) < 0)
+		goto error;
 	data.res = isl_union_map_alloc(isl_space_copy(umap1->dim),
 				       umap1->table.n);
 	if (isl_hash_table_foreach(umap1->dim->ctx, &umap1->table,
 				   &bin_entry, &data) < 0)
 		goto error;
 
+	free_index(umap1->dim->ctx, data.index);
 	isl_union_map_free(umap1);
 	isl_union_map_free(umap2);
 	return data.res;
 error:
+	if (umap2)
+		free_index(umap2->dim->ctx, data.index);
 	isl_union_map_free(umap1);
 	isl_union_map_free(umap2);
 	isl_union_map_free(data.res);
 	return NULL;
 }
 
+static __isl_give isl_union_map *bin_op(__isl_take isl_union_map *umap1,
+	__isl_take isl_union_map *umap2,
+	isl_stat (*fn)(void **entry, void *user))
+{
+	return match_tuple_bin_op(umap1, umap2, 0, isl_dim_in, isl_dim_in, fn);
+}
+
 __isl_give isl_union_map *isl_union_map_apply_range(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &apply_range_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_out, isl_dim_in,
+				  &apply_range_entry);
 }
 
 __isl_give isl_union_map *isl_union_map_apply_domain(
@@ -1332,7 +1732,8 @@ static isl_stat map_lex_lt_entry(void **entry, void *user)
 __isl_give isl_union_map *isl_union_map_lex_lt_union_map(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &map_lex_lt_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_out, isl_dim_out,
+				  &map_lex_lt_entry);
 }
 
 static isl_stat map_lex_le_entry(void **entry, void *user)
@@ -1354,7 +1755,8 @@ static isl_stat map_lex_le_entry(void **entry, void *user)
 __isl_give isl_union_map *isl_union_map_lex_le_union_map(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &map_lex_le_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_out, isl_dim_out,
+				  &map_lex_le_entry);
 }
 
 static isl_stat product_entry(void **entry, void *user)
@@ -1415,7 +1817,8 @@ static isl_stat domain_product_entry(void **entry, void *user)
 __isl_give isl_union_map *isl_union_map_domain_product(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &domain_product_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_out, isl_dim_out,
+				  &domain_product_entry);
 }
 
 static isl_stat range_product_entry(void **entry, void *user)
@@ -1438,7 +1841,8 @@ static isl_stat range_product_entry(void **entry, void *user)
 __isl_give isl_union_map *isl_union_map_range_product(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &range_product_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_in, isl_dim_in,
+				  &range_product_entry);
 }
 
 /* If data->map A -> B and "map2" C -> D have the same range space,
@@ -1466,7 +1870,8 @@ static isl_stat flat_domain_product_entry(void **entry, void *user)
 __isl_give isl_union_map *isl_union_map_flat_domain_product(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &flat_domain_product_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_out, isl_dim_out,
+				  &flat_domain_product_entry);
 }
 
 static isl_stat flat_range_product_entry(void **entry, void *user)
@@ -1489,7 +1894,8 @@ static isl_stat flat_range_product_entry(void **entry, void *user)
 __isl_give isl_union_map *isl_union_map_flat_range_product(
 	__isl_take isl_union_map *umap1, __isl_take isl_union_map *umap2)
 {
-	return bin_op(umap1, umap2, &flat_range_product_entry);
+	return match_tuple_bin_op(umap1, umap2, 1, isl_dim_in, isl_dim_in,
+				  &flat_range_product_entry);
 }
 
 static __isl_give isl_union_set *cond_un_op(__isl_take isl_union_map *umap,
@@ -1638,14 +2044,41 @@ static isl_stat inplace_entry(void **entry, void *user)
 	return isl_stat_ok;
 }
 
+/* Apply the function pointed to by "user" to *entry and
+ * store the result in *entry, without keeping a copy
+ * of the original map.
+ */
+static isl_stat inplace_take_entry(void **entry, void *user)
+{
+	__isl_give isl_map *(*fn)(__isl_take isl_map *);
+	isl_map **map = (isl_map **)entry;
+
+	fn = *(__isl_give isl_map *(**)(__isl_take isl_map *)) user;
+	*map = fn(*map);
+
+	return *map ? isl_stat_ok : isl_stat_error;
+}
+
+/* Apply "fn" to each map in "umap", replacing the map by the result.
+ * "fn" is assumed not to change the meaning nor the space of the map.
+ *
+ * If "umap" is shared, then the other references see the same maps,
+ * so a map is only replaced if "fn" succeeds.
+ * Otherwise, "umap" is discarded on failure and the maps
+ * can be passed to "fn" directly, allowing "fn" to modify them
+ * in place rather than operating on a copy.
+ */
 static __isl_give isl_union_map *inplace(__isl_take isl_union_map *umap,
 	__isl_give isl_map *(*fn)(__isl_take isl_map *))
 {
+	isl_stat (*entry_fn)(void **entry, void *user);
+
 	if (!umap)
 		return NULL;
 
+	entry_fn = umap->ref == 1 ? &inplace_take_entry : &inplace_entry;
 	if (isl_hash_table_foreach(umap->dim->ctx, &umap->table,
-				    &inplace_entry, &fn) < 0)
+				    entry_fn, &fn) < 0)
 		goto error;
 
 	return umap;
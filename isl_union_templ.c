@@ -409,10 +409,15 @@ error:
 }
 
 /* Align the parameters of "u" to those of "model".
+ *
+ * If the parameters of "model" already appear in the same order
+ * at the start of those of "u", then the alignment does not
+ * change anything and "u" is returned directly.
  */
 __isl_give UNION *FN(UNION,align_params)(__isl_take UNION *u,
 	__isl_take isl_space *model)
 {
+	isl_bool identity;
 	isl_reordering *r;
 
 	if (!u || !model)
@@ -427,6 +432,14 @@ __isl_give UNION *FN(UNION,align_params)(__isl_take UNION *u,
 	r = isl_parameter_alignment_reordering(u->space, model);
 	isl_space_free(model);
 
+	identity = isl_reordering_is_identity(r);
+	if (identity < 0 || identity) {
+		isl_reordering_free(r);
+		if (identity < 0)
+			return FN(UNION,free)(u);
+		return u;
+	}
+
 	return FN(UNION,realign_domain)(u, r);
 error:
 	isl_space_free(model);
@@ -785,34 +798,19 @@ __isl_give UNION *FN(UNION,gist)(__isl_take UNION *u,
 	return FN(UNION,match_domain_op)(u, uset, &FN(PW,gist));
 }
 
-/* Coalesce an entry in a UNION.  Coalescing is performed in-place.
- * Since the UNION may have several references, the entry is only
- * replaced if the coalescing is successful.
+/* Coalesce "part" and return the result.
  */
-static isl_stat FN(UNION,coalesce_entry)(void **entry, void *user)
+static __isl_give PART *FN(UNION,coalesce_entry)(__isl_take PART *part,
+	void *user)
 {
-	PART **part_p = (PART **) entry;
-	PART *part;
-
-	part = FN(PART,copy)(*part_p);
-	part = FN(PW,coalesce)(part);
-	if (!part)
-		return isl_stat_error;
-	FN(PART,free)(*part_p);
-	*part_p = part;
-
-	return isl_stat_ok;
+	return FN(PW,coalesce)(part);
 }
 
+/* Coalesce each of the entries of "u".
+ */
 __isl_give UNION *FN(UNION,coalesce)(__isl_take UNION *u)
 {
-	if (FN(UNION,foreach_inplace)(u, &FN(UNION,coalesce_entry), NULL) < 0)
-		goto error;
-
-	return u;
-error:
-	FN(UNION,free)(u);
-	return NULL;
+	return FN(UNION,transform_inplace)(u, &FN(UNION,coalesce_entry), NULL);
 }
 
 static isl_stat FN(UNION,domain_entry)(__isl_take PART *part, void *user)
@@ -1613,6 +1613,55 @@ int isl_val_check_match_domain_space(__isl_keep isl_val *v,
 #define NO_MOVE_DIMS
 #include <isl_multi_templ.c>
 
+/* Return a copy of "val" that lives in "ctx".
+ */
+static __isl_give isl_val *val_dup_to_ctx(__isl_keep isl_val *val,
+	isl_ctx *ctx)
+{
+	isl_val *dup;
+
+	if (!val)
+		return NULL;
+
+	dup = isl_val_alloc(ctx);
+	if (!dup)
+		return NULL;
+
+	isl_int_set(dup->n, val->n);
+	isl_int_set(dup->d, val->d);
+
+	return dup;
+}
+
+/* Return a copy of "mv" that lives in "ctx".
+ * The elements of "mv" are only read, such that only the reference
+ * count of "mv" itself is affected.
+ * If "mv" already lives in "ctx", then it is returned unchanged.
+ */
+__isl_give isl_multi_val *isl_multi_val_transfer(__isl_take isl_multi_val *mv,
+	isl_ctx *ctx)
+{
+	int i;
+	isl_space *space;
+	isl_multi_val *res;
+
+	if (!mv || !ctx)
+		return isl_multi_val_free(mv);
+	if (isl_multi_val_get_ctx(mv) == ctx)
+		return mv;
+
+	space = isl_space_transfer(isl_space_copy(mv->space), ctx);
+	res = isl_multi_val_alloc(space);
+	for (i = 0; res && i < mv->n; ++i) {
+		res->p[i] = val_dup_to_ctx(mv->p[i], ctx);
+		if (!res->p[i])
+			res = isl_multi_val_free(res);
+	}
+
+	isl_multi_val_free(mv);
+	return res;
+}
+
 /* Apply "fn" to each of the elements of "mv" with as second argument "v".
  */
 static __isl_give isl_multi_val *isl_multi_val_fn_val(
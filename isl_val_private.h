@@ -69,4 +69,7 @@ int isl_val_check_match_domain_space(__isl_keep isl_val *v,
 
 #include <isl_multi_templ.h>
 
+__isl_give isl_multi_val *isl_multi_val_transfer(__isl_take isl_multi_val *mv,
+	isl_ctx *ctx);
+
 #endif
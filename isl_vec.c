@@ -203,6 +203,23 @@ struct isl_vec *isl_vec_dup(struct isl_vec *vec)
 	return vec2;
 }
 
+/* Return a copy of "vec" that lives in "ctx".
+ * Only the elements of "vec" are read, such that "vec" may be
+ * duplicated from a thread other than the one that owns its context.
+ */
+__isl_give isl_vec *isl_vec_dup_to_ctx(__isl_keep isl_vec *vec, isl_ctx *ctx)
+{
+	isl_vec *dup;
+
+	if (!vec)
+		return NULL;
+	dup = isl_vec_alloc(ctx, vec->size);
+	if (!dup)
+		return NULL;
+	isl_seq_cpy(dup->el, vec->el, vec->size);
+	return dup;
+}
+
 struct isl_vec *isl_vec_cow(struct isl_vec *vec)
 {
 	struct isl_vec *vec2;
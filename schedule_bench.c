@@ -0,0 +1,435 @@
+/* This program computes a schedule for each of the schedule constraints
+ * in the input files and reports, for each of them, the time it took,
+ * the number of LPs that were solved and the band structure
+ * of the resulting schedule.
+ *
+ * Each input file contains an isl_schedule_constraints object
+ * in YAML format.  The output consists of one line per input file,
+ * with the following fields separated by tabs
+ *
+ *	name	time_ms	band_lp	carry_lp	bands
+ *
+ * where "name" is the base name of the input file without ".sc" extension,
+ * "band_lp" and "carry_lp" are the number of LPs solved to compute
+ * bands and to carry dependences and "bands" describes the structure
+ * of the schedule tree.  A band with n members is represented by "Bn",
+ * a sequence or set by "seq(...)" or "set(...)" with its children
+ * separated by commas, a band with a non-leaf child by the band
+ * followed by a period and the description of the child and
+ * any other leaf by "L".
+ *
+ * The output can be used as a baseline for later runs.
+ * If a baseline is specified, then each line is extended with
+ * the time in the baseline, the ratio of the current time
+ * to that in the baseline and a status, which is one of
+ *
+ *	ok	the results are the same (and the time is within the tolerance)
+ *	slower	the results are the same, but the time is beyond the tolerance
+ *	changed	the number of LPs or the band structure changed
+ *	new	the input does not appear in the baseline
+ *
+ * The times in a baseline depend on the machine and the build
+ * on which it was produced, so they are only compared
+ * if a (non-negative) tolerance is specified explicitly.
+ * Otherwise, only the number of LPs and the band structure are compared.
+ * The program returns a non-zero exit status if any of the inputs
+ * could not be scheduled, got slower or changed.
+ * For example,
+ *
+ *	isl_schedule_bench --baseline=test_inputs/schedule/baseline \
+ *		test_inputs/schedule/gemm.sc test_inputs/schedule/lu.sc
+ *
+ * checks that the schedules of the given inputs have not changed, while
+ *
+ *	isl_schedule_bench --baseline=my_baseline --tolerance=25 \
+ *		test_inputs/schedule/gemm.sc test_inputs/schedule/lu.sc
+ *
+ * also checks that they did not get more than 25% slower with respect to
+ * a baseline produced earlier on the same machine.
+ * Times are measured in CPU time, so the scheduler should not use
+ * a thread pool when comparing against a baseline.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <isl/ctx.h>
+#include <isl/options.h>
+#include <isl/printer.h>
+#include <isl/schedule.h>
+#include <isl/schedule_node.h>
+
+struct options {
+	struct isl_options	*isl;
+	char			*baseline;
+	int			 tolerance;
+	int			 repeat;
+};
+
+ISL_ARGS_START(struct options, options_args)
+ISL_ARG_CHILD(struct options, isl, "isl", &isl_options_args, "isl options")
+ISL_ARG_STR(struct options, baseline, 0, "baseline", "file", NULL,
+	"compare against the results in this file")
+ISL_ARG_INT(struct options, tolerance, 0, "tolerance", "percent", -1,
+	"allowed slowdown with respect to the baseline "
+	"(negative: do not compare times)")
+ISL_ARG_INT(struct options, repeat, 0, "repeat", "n", 1,
+	"number of times each schedule is computed (minimal time is reported)")
+ISL_ARGS_END
+
+ISL_ARG_DEF(options, struct options, options_args)
+
+/* The results for a single input.
+ */
+struct bench_result {
+	char name[256];
+	double time_ms;
+	int band_lp;
+	int carry_lp;
+	char bands[1024];
+};
+
+/* A baseline, containing "n" results.
+ */
+struct bench_baseline {
+	int n;
+	struct bench_result *result;
+};
+
+static __isl_give isl_printer *print_bands(__isl_take isl_printer *p,
+	__isl_keep isl_schedule_node *node);
+
+/* Print a description of the children of "node" to "p",
+ * enclosed in parentheses and separated by commas.
+ */
+static __isl_give isl_printer *print_children(__isl_take isl_printer *p,
+	__isl_keep isl_schedule_node *node)
+{
+	int i, n;
+
+	n = isl_schedule_node_n_children(node);
+	p = isl_printer_print_str(p, "(");
+	for (i = 0; i < n; ++i) {
+		isl_schedule_node *child;
+
+		if (i)
+			p = isl_printer_print_str(p, ",");
+		child = isl_schedule_node_get_child(node, i);
+		p = print_bands(p, child);
+		isl_schedule_node_free(child);
+	}
+	p = isl_printer_print_str(p, ")");
+
+	return p;
+}
+
+/* Print a description of the band structure of the subtree at "node"
+ * to "p".
+ * Nodes other than band, sequence and set nodes are transparent.
+ */
+static __isl_give isl_printer *print_bands(__isl_take isl_printer *p,
+	__isl_keep isl_schedule_node *node)
+{
+	isl_schedule_node *child;
+
+	switch (isl_schedule_node_get_type(node)) {
+	case isl_schedule_node_error:
+		return isl_printer_free(p);
+	case isl_schedule_node_leaf:
+		return isl_printer_print_str(p, "L");
+	case isl_schedule_node_sequence:
+		p = isl_printer_print_str(p, "seq");
+		return print_children(p, node);
+	case isl_schedule_node_set:
+		p = isl_printer_print_str(p, "set");
+		return print_children(p, node);
+	case isl_schedule_node_band:
+		p = isl_printer_print_str(p, "B");
+		p = isl_printer_print_int(p,
+					isl_schedule_node_band_n_member(node));
+		child = isl_schedule_node_get_child(node, 0);
+		if (isl_schedule_node_get_type(child) !=
+		    isl_schedule_node_leaf) {
+			p = isl_printer_print_str(p, ".");
+			p = print_bands(p, child);
+		}
+		isl_schedule_node_free(child);
+		return p;
+	default:
+		child = isl_schedule_node_get_child(node, 0);
+		p = print_bands(p, child);
+		isl_schedule_node_free(child);
+		return p;
+	}
+}
+
+/* Store a description of the band structure of "schedule"
+ * in res->bands.
+ */
+static int set_bands(struct bench_result *res,
+	__isl_keep isl_schedule *schedule)
+{
+	isl_schedule_node *root;
+	isl_printer *p;
+	char *s;
+
+	root = isl_schedule_get_root(schedule);
+	p = isl_printer_to_str(isl_schedule_get_ctx(schedule));
+	p = print_bands(p, root);
+	s = isl_printer_get_str(p);
+	isl_printer_free(p);
+	isl_schedule_node_free(root);
+	if (!s)
+		return -1;
+	snprintf(res->bands, sizeof(res->bands), "%s", s);
+	free(s);
+
+	return 0;
+}
+
+/* Extract the LP count of the section "section" of the scheduler
+ * statistics "stats", as produced by isl_ctx_schedule_stats_to_str.
+ */
+static int lp_count(const char *stats, const char *section)
+{
+	const char *s;
+	int count;
+
+	s = strstr(stats, section);
+	if (s)
+		s = strstr(s, "count:");
+	if (!s || sscanf(s, "count: %d", &count) != 1)
+		return -1;
+
+	return count;
+}
+
+/* Store the LP counts of the most recent schedule computation in "ctx"
+ * in "res".
+ */
+static int set_lp_counts(struct bench_result *res, isl_ctx *ctx)
+{
+	char *stats;
+
+	stats = isl_ctx_schedule_stats_to_str(ctx);
+	if (!stats)
+		return -1;
+	res->band_lp = lp_count(stats, "band_lp:");
+	res->carry_lp = lp_count(stats, "carry_lp:");
+	free(stats);
+
+	if (res->band_lp < 0 || res->carry_lp < 0)
+		return -1;
+	return 0;
+}
+
+/* Set res->name to the base name of "filename" without ".sc" extension.
+ */
+static void set_name(struct bench_result *res, const char *filename)
+{
+	const char *base;
+	size_t len;
+
+	base = strrchr(filename, '/');
+	base = base ? base + 1 : filename;
+	len = strlen(base);
+	if (len > 3 && !strcmp(base + len - 3, ".sc"))
+		len -= 3;
+	if (len >= sizeof(res->name))
+		len = sizeof(res->name) - 1;
+	memcpy(res->name, base, len);
+	res->name[len] = '\0';
+}
+
+/* Compute a schedule for the schedule constraints in "filename"
+ * "repeat" times and store the results in "res".
+ */
+static int bench(isl_ctx *ctx, const char *filename, int repeat,
+	struct bench_result *res)
+{
+	FILE *input;
+	isl_schedule_constraints *sc;
+	int i;
+
+	set_name(res, filename);
+	input = fopen(filename, "r");
+	if (!input) {
+		fprintf(stderr, "unable to open %s\n", filename);
+		return -1;
+	}
+	sc = isl_schedule_constraints_read_from_file(ctx, input);
+	fclose(input);
+	if (!sc)
+		return -1;
+
+	res->time_ms = -1;
+	for (i = 0; i < repeat; ++i) {
+		isl_schedule *schedule;
+		clock_t start, end;
+		double time_ms;
+		int r = 0;
+
+		start = clock();
+		schedule = isl_schedule_constraints_compute_schedule(
+					isl_schedule_constraints_copy(sc));
+		end = clock();
+		time_ms = 1000.0 * (end - start) / CLOCKS_PER_SEC;
+		if (res->time_ms < 0 || time_ms < res->time_ms)
+			res->time_ms = time_ms;
+		if (!schedule || set_lp_counts(res, ctx) < 0 ||
+		    set_bands(res, schedule) < 0)
+			r = -1;
+		isl_schedule_free(schedule);
+		if (r < 0)
+			break;
+	}
+	isl_schedule_constraints_free(sc);
+
+	return i < repeat ? -1 : 0;
+}
+
+/* Read a baseline in the output format of this program from "filename".
+ * Lines starting with '#' are ignored.
+ */
+static int read_baseline(const char *filename, struct bench_baseline *base)
+{
+	FILE *input;
+	char line[2048];
+	int size = 0;
+
+	base->n = 0;
+	base->result = NULL;
+	input = fopen(filename, "r");
+	if (!input) {
+		fprintf(stderr, "unable to open %s\n", filename);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), input)) {
+		struct bench_result *res;
+
+		if (line[0] == '#')
+			continue;
+		if (base->n >= size) {
+			size = 2 * size + 16;
+			res = realloc(base->result, size * sizeof(*res));
+			if (!res) {
+				fclose(input);
+				return -1;
+			}
+			base->result = res;
+		}
+		res = &base->result[base->n];
+		if (sscanf(line, "%255s %lf %d %d %1023s", res->name,
+			    &res->time_ms, &res->band_lp, &res->carry_lp,
+			    res->bands) == 5)
+			base->n++;
+	}
+	fclose(input);
+
+	return 0;
+}
+
+/* Return the result with name "name" in "base" or NULL
+ * if there is no such result.
+ */
+static struct bench_result *find_baseline(struct bench_baseline *base,
+	const char *name)
+{
+	int i;
+
+	for (i = 0; i < base->n; ++i)
+		if (!strcmp(base->result[i].name, name))
+			return &base->result[i];
+
+	return NULL;
+}
+
+/* Print the result "res", comparing it against "base" if it is not NULL.
+ * The time is only compared if "tolerance" is non-negative.
+ * Return 1 if the comparison should be considered to have failed.
+ */
+static int report(struct bench_result *res, struct bench_baseline *base,
+	int tolerance)
+{
+	struct bench_result *old;
+	const char *status;
+	int failed;
+
+	printf("%s\t%.3f\t%d\t%d\t%s", res->name, res->time_ms,
+		res->band_lp, res->carry_lp, res->bands);
+	if (!base) {
+		printf("\n");
+		return 0;
+	}
+
+	old = find_baseline(base, res->name);
+	if (!old) {
+		printf("\t-\t-\tnew\n");
+		return 0;
+	}
+	if (old->band_lp != res->band_lp || old->carry_lp != res->carry_lp ||
+	    strcmp(old->bands, res->bands))
+		status = "changed";
+	else if (tolerance >= 0 &&
+		    res->time_ms > old->time_ms * (100 + tolerance) / 100)
+		status = "slower";
+	else
+		status = "ok";
+	failed = strcmp(status, "ok") != 0;
+	printf("\t%.3f\t", old->time_ms);
+	if (old->time_ms > 0)
+		printf("%.2f", res->time_ms / old->time_ms);
+	else
+		printf("-");
+	printf("\t%s\n", status);
+
+	return failed;
+}
+
+int main(int argc, char **argv)
+{
+	isl_ctx *ctx;
+	struct options *options;
+	struct bench_baseline base = { 0 };
+	int i;
+	int r = 0;
+
+	options = options_new_with_defaults();
+	argc = options_parse(options, argc, argv, 0);
+	if (options->repeat < 1)
+		options->repeat = 1;
+
+	if (options->baseline && read_baseline(options->baseline, &base) < 0)
+		return EXIT_FAILURE;
+
+	ctx = isl_ctx_alloc_with_options(&options_args, options);
+
+	printf("# input\ttime_ms\tband_lp\tcarry_lp\tbands");
+	if (options->baseline)
+		printf("\tbase_ms\tratio\tstatus");
+	printf("\n");
+	for (i = 1; i < argc; ++i) {
+		struct bench_result res;
+
+		if (argv[i][0] == '-') {
+			fprintf(stderr, "%s: unrecognized option: %s\n",
+				argv[0], argv[i]);
+			r = 1;
+			continue;
+		}
+		if (bench(ctx, argv[i], options->repeat, &res) < 0) {
+			fprintf(stderr, "failed to schedule %s\n", argv[i]);
+			r = 1;
+			continue;
+		}
+		if (report(&res, options->baseline ? &base : NULL,
+			    options->tolerance))
+			r = 1;
+	}
+
+	free(base.result);
+	isl_ctx_free(ctx);
+
+	return r;
+}
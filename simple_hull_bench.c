@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <time.h>
+#include <isl_ctx_private.h>
+#include <isl/set.h>
+
+/* The number of times the simple hull of each input is computed.
+ */
+#define REPEAT	100
+
+/* Read the first two basic sets from the PolyLib file "filename",
+ * in the format of the test_inputs/convex*.polylib files, and
+ * print the average time needed to compute the simple hull
+ * of their union, together with the number of LPs solved and
+ * the number of LPs that were avoided by checking a bounding box.
+ */
+static int bench_file(isl_ctx *ctx, const char *filename)
+{
+	int i;
+	FILE *input;
+	isl_basic_set *bset1, *bset2;
+	isl_set *set;
+	long lps, box;
+	clock_t start, end;
+
+	input = fopen(filename, "r");
+	if (!input) {
+		fprintf(stderr, "unable to open %s\n", filename);
+		return -1;
+	}
+	bset1 = isl_basic_set_read_from_file(ctx, input);
+	bset2 = isl_basic_set_read_from_file(ctx, input);
+	fclose(input);
+	set = isl_basic_set_union(bset1, bset2);
+	if (!set)
+		return -1;
+
+	lps = ctx->stats->simple_hull_lps;
+	box = ctx->stats->simple_hull_box_bounds;
+	start = clock();
+	for (i = 0; i < REPEAT; ++i) {
+		isl_basic_set *hull;
+		hull = isl_set_simple_hull(isl_set_copy(set));
+		isl_basic_set_free(hull);
+		if (!hull)
+			break;
+	}
+	end = clock();
+	isl_set_free(set);
+	if (i < REPEAT)
+		return -1;
+
+	printf("%s: %.3f ms, %ld LPs, %ld box bounds\n", filename,
+		1000.0 * (end - start) / CLOCKS_PER_SEC / REPEAT,
+		(ctx->stats->simple_hull_lps - lps) / REPEAT,
+		(ctx->stats->simple_hull_box_bounds - box) / REPEAT);
+
+	return 0;
+}
+
+/* Report the latency of isl_set_simple_hull on each of
+ * the PolyLib files specified on the command line, e.g.,
+ *
+ *	isl_simple_hull_bench test_inputs/convex*.polylib
+ */
+int main(int argc, char **argv)
+{
+	int i;
+	int r = 0;
+	isl_ctx *ctx;
+
+	ctx = isl_ctx_alloc();
+	for (i = 1; i < argc; ++i)
+		if (bench_file(ctx, argv[i]) < 0)
+			r = 1;
+	isl_ctx_free(ctx);
+
+	return r;
+}
@@ -0,0 +1,6 @@
+domain: "[NI, NJ, NK, NL] -> { S2[i, j] : 0 <= i < NI and 0 <= j < NL; S0[i, j] : 0 <= i < NI and 0 <= j < NJ; S1[i, j, k] : 0 <= i < NI and 0 <= j < NJ and 0 <= k < NK; S3[i, j, k] : 0 <= i < NI and 0 <= j < NL and 0 <= k < NJ }"
+context: "[NI, NJ, NK, NL] -> {  : NI > 0 and NJ > 0 and NK > 0 and NL > 0 }"
+validity: "[NI, NJ, NK, NL] -> { S1[i, j, k] -> S1[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NJ and k >= 0 and k < k' < NK; S3[i, j, k] -> S3[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NL and k >= 0 and k < k' < NJ; S1[i, j, k = -1 + NK] -> S3[i' = i, j', k' = j] : 0 <= i < NI and 0 <= j < NJ and 0 <= j' < NL; S0[i, j] -> S1[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NJ; S2[i, j] -> S3[i' = i, j' = j, k] : 0 <= i < NI and 0 <= j < NL and 0 <= k < NJ; S2[i, j] -> S3[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NL }"
+coincidence: "[NI, NJ, NK, NL] -> { S1[i, j, k] -> S1[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NJ and k >= 0 and k < k' < NK; S3[i, j, k] -> S3[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NL and k >= 0 and k < k' < NJ; S1[i, j, k = -1 + NK] -> S3[i' = i, j', k' = j] : 0 <= i < NI and 0 <= j < NJ and 0 <= j' < NL; S0[i, j] -> S1[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NJ; S2[i, j] -> S3[i' = i, j' = j, k] : 0 <= i < NI and 0 <= j < NL and 0 <= k < NJ; S2[i, j] -> S3[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NL }"
+proximity: "[NI, NJ, NK, NL] -> { S1[i, j, k] -> S1[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NJ and k >= 0 and k < k' < NK; S3[i, j, k] -> S3[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NL and k >= 0 and k < k' < NJ; S1[i, j, k = -1 + NK] -> S3[i' = i, j', k' = j] : 0 <= i < NI and 0 <= j < NJ and 0 <= j' < NL; S0[i, j] -> S1[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NJ; S2[i, j] -> S3[i' = i, j' = j, k] : 0 <= i < NI and 0 <= j < NL and 0 <= k < NJ; S2[i, j] -> S3[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NL }"
+
@@ -0,0 +1,6 @@
+domain: "[N, M] -> { BY[i, j] : 0 <= i <= -3 + N and 0 <= j <= -3 + M; BX[i, j] : 0 <= i < N and 0 <= j <= -3 + M }"
+context: "[N, M] -> {  : N >= 4 and M >= 4 }"
+validity: "[N, M] -> { BX[i, j] -> BY[i', j' = j] : 0 <= j <= -3 + M and i' >= -2 + i and 0 <= i' <= i and i' <= -3 + N }"
+coincidence: "[N, M] -> { BX[i, j] -> BY[i', j' = j] : 0 <= j <= -3 + M and i' >= -2 + i and 0 <= i' <= i and i' <= -3 + N }"
+proximity: "[N, M] -> { BX[i, j] -> BY[i', j' = j] : 0 <= j <= -3 + M and i' >= -2 + i and 0 <= i' <= i and i' <= -3 + N }"
+
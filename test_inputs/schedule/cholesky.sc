@@ -0,0 +1,6 @@
+domain: "[N] -> { S2[i, k] : i < N and 0 <= k < i; S0[i, j, k] : i < N and j < i and 0 <= k < j; S3[i] : 0 <= i < N; S1[i, j] : i < N and 0 <= j < i }"
+context: "[N] -> {  : N >= 2 }"
+validity: "[N] -> { S1[i, j] -> S2[i' = i, k = j] : i < N and 0 <= j < i; S0[i, j, k] -> S1[i' = i, j' = j] : i < N and j < i and 0 <= k < j; S2[i, k] -> S2[i' = i, k'] : i < N and k >= 0 and k < k' < i; S0[i, j, k] -> S0[i' = i, j' = j, k'] : i < N and j < i and k >= 0 and k < k' < j; S2[i, k] -> S3[i' = i] : i < N and 0 <= k < i; S1[i, j] -> S0[i', j' = i, k = j] : 0 <= j < i and i < i' < N; S1[i, j] -> S0[i' = i, j', k = j] : i < N and j >= 0 and j < j' < i; S3[i] -> S1[i', j = i] : i >= 0 and i < i' < N }"
+coincidence: "[N] -> { S1[i, j] -> S2[i' = i, k = j] : i < N and 0 <= j < i; S0[i, j, k] -> S1[i' = i, j' = j] : i < N and j < i and 0 <= k < j; S2[i, k] -> S2[i' = i, k'] : i < N and k >= 0 and k < k' < i; S0[i, j, k] -> S0[i' = i, j' = j, k'] : i < N and j < i and k >= 0 and k < k' < j; S2[i, k] -> S3[i' = i] : i < N and 0 <= k < i; S1[i, j] -> S0[i', j' = i, k = j] : 0 <= j < i and i < i' < N; S1[i, j] -> S0[i' = i, j', k = j] : i < N and j >= 0 and j < j' < i; S3[i] -> S1[i', j = i] : i >= 0 and i < i' < N }"
+proximity: "[N] -> { S1[i, j] -> S2[i' = i, k = j] : i < N and 0 <= j < i; S0[i, j, k] -> S1[i' = i, j' = j] : i < N and j < i and 0 <= k < j; S2[i, k] -> S2[i' = i, k'] : i < N and k >= 0 and k < k' < i; S0[i, j, k] -> S0[i' = i, j' = j, k'] : i < N and j < i and k >= 0 and k < k' < j; S2[i, k] -> S3[i' = i] : i < N and 0 <= k < i; S1[i, j] -> S0[i', j' = i, k = j] : 0 <= j < i and i < i' < N; S1[i, j] -> S0[i' = i, j', k = j] : i < N and j >= 0 and j < j' < i; S3[i] -> S1[i', j = i] : i >= 0 and i < i' < N }"
+
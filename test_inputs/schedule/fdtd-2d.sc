@@ -0,0 +1,6 @@
+domain: "[N, M, T] -> { S1[t, i, j] : 0 <= t < T and 0 < i < N and 0 <= j < M; S2[t, i, j] : 0 <= t < T and 0 <= i < N and 0 < j < M; S3[t, i, j] : 0 <= t < T and 0 <= i <= -2 + N and 0 <= j <= -2 + M; S0[t, j] : 0 <= t < T and 0 <= j < M }"
+context: "[N, M, T] -> {  : N >= 4 and M >= 4 and T > 0 }"
+validity: "[N, M, T] -> { S2[t, i, j] -> S3[t', i' = i, j'] : t >= 0 and 0 <= i <= -2 + N and j > 0 and t <= t' < T and -1 + j <= j' <= j and j' <= -2 + M; S3[t, i, j] -> S2[t', i' = i, j'] : t >= 0 and 0 <= i <= -2 + N and j <= -2 + M and t < t' < T and j' >= j and 0 < j' <= 1 + j; S0[t, j] -> S0[t' = 1 + t, j' = j] : 0 <= t <= -2 + T and 0 <= j < M; S2[t, i, j] -> S2[t', i' = i, j' = j] : t >= 0 and 0 <= i < N and 0 < j < M and t < t' < T; S1[t, i, j] -> S1[t', i' = i, j' = j] : t >= 0 and 0 < i < N and 0 <= j < M and t < t' < T; S1[t, i, j] -> S3[t', i', j' = j] : t >= 0 and i > 0 and 0 <= j <= -2 + M and t <= t' < T and -1 + i <= i' <= i and i' <= -2 + N; S0[t, j] -> S3[t' = t, i = 0, j' = j] : 0 <= t < T and 0 <= j <= -2 + M; S3[t, i, j] -> S1[t', i', j' = j] : t >= 0 and i <= -2 + N and 0 <= j <= -2 + M and t < t' < T and i' >= i and 0 < i' <= 1 + i; S3[t, i, j] -> S3[t', i' = i, j' = j] : t >= 0 and 0 <= i <= -2 + N and 0 <= j <= -2 + M and t < t' < T; S3[t, i = 0, j] -> S0[t', j' = j] : t >= 0 and 0 <= j <= -2 + M and t < t' < T }"
+coincidence: "[N, M, T] -> { S2[t, i, j] -> S3[t', i' = i, j'] : t >= 0 and 0 <= i <= -2 + N and j > 0 and t <= t' < T and -1 + j <= j' <= j and j' <= -2 + M; S3[t, i, j] -> S2[t', i' = i, j'] : t >= 0 and 0 <= i <= -2 + N and j <= -2 + M and t < t' < T and j' >= j and 0 < j' <= 1 + j; S0[t, j] -> S0[t' = 1 + t, j' = j] : 0 <= t <= -2 + T and 0 <= j < M; S2[t, i, j] -> S2[t', i' = i, j' = j] : t >= 0 and 0 <= i < N and 0 < j < M and t < t' < T; S1[t, i, j] -> S1[t', i' = i, j' = j] : t >= 0 and 0 < i < N and 0 <= j < M and t < t' < T; S1[t, i, j] -> S3[t', i', j' = j] : t >= 0 and i > 0 and 0 <= j <= -2 + M and t <= t' < T and -1 + i <= i' <= i and i' <= -2 + N; S0[t, j] -> S3[t' = t, i = 0, j' = j] : 0 <= t < T and 0 <= j <= -2 + M; S3[t, i, j] -> S1[t', i', j' = j] : t >= 0 and i <= -2 + N and 0 <= j <= -2 + M and t < t' < T and i' >= i and 0 < i' <= 1 + i; S3[t, i, j] -> S3[t', i' = i, j' = j] : t >= 0 and 0 <= i <= -2 + N and 0 <= j <= -2 + M and t < t' < T; S3[t, i = 0, j] -> S0[t', j' = j] : t >= 0 and 0 <= j <= -2 + M and t < t' < T }"
+proximity: "[N, M, T] -> { S2[t, i, j] -> S3[t', i' = i, j'] : t >= 0 and 0 <= i <= -2 + N and j > 0 and t <= t' < T and -1 + j <= j' <= j and j' <= -2 + M; S3[t, i, j] -> S2[t', i' = i, j'] : t >= 0 and 0 <= i <= -2 + N and j <= -2 + M and t < t' < T and j' >= j and 0 < j' <= 1 + j; S0[t, j] -> S0[t' = 1 + t, j' = j] : 0 <= t <= -2 + T and 0 <= j < M; S2[t, i, j] -> S2[t', i' = i, j' = j] : t >= 0 and 0 <= i < N and 0 < j < M and t < t' < T; S1[t, i, j] -> S1[t', i' = i, j' = j] : t >= 0 and 0 < i < N and 0 <= j < M and t < t' < T; S1[t, i, j] -> S3[t', i', j' = j] : t >= 0 and i > 0 and 0 <= j <= -2 + M and t <= t' < T and -1 + i <= i' <= i and i' <= -2 + N; S0[t, j] -> S3[t' = t, i = 0, j' = j] : 0 <= t < T and 0 <= j <= -2 + M; S3[t, i, j] -> S1[t', i', j' = j] : t >= 0 and i <= -2 + N and 0 <= j <= -2 + M and t < t' < T and i' >= i and 0 < i' <= 1 + i; S3[t, i, j] -> S3[t', i' = i, j' = j] : t >= 0 and 0 <= i <= -2 + N and 0 <= j <= -2 + M and t < t' < T; S3[t, i = 0, j] -> S0[t', j' = j] : t >= 0 and 0 <= j <= -2 + M and t < t' < T }"
+
@@ -0,0 +1,6 @@
+domain: "[NI, NJ, NK] -> { S0[i, j] : 0 <= i < NI and 0 <= j < NJ; S1[i, j, k] : 0 <= i < NI and 0 <= j < NJ and 0 <= k < NK }"
+context: "[NI, NJ, NK] -> {  : NI > 0 and NJ > 0 and NK > 0 }"
+validity: "[NI, NJ, NK] -> { S1[i, j, k] -> S1[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NJ and k >= 0 and k < k' < NK; S0[i, j] -> S1[i' = i, j' = j, k] : 0 <= i < NI and 0 <= j < NJ and 0 <= k < NK; S0[i, j] -> S1[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NJ }"
+coincidence: "[NI, NJ, NK] -> { S1[i, j, k] -> S1[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NJ and k >= 0 and k < k' < NK; S0[i, j] -> S1[i' = i, j' = j, k] : 0 <= i < NI and 0 <= j < NJ and 0 <= k < NK; S0[i, j] -> S1[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NJ }"
+proximity: "[NI, NJ, NK] -> { S1[i, j, k] -> S1[i' = i, j' = j, k'] : 0 <= i < NI and 0 <= j < NJ and k >= 0 and k < k' < NK; S0[i, j] -> S1[i' = i, j' = j, k] : 0 <= i < NI and 0 <= j < NJ and 0 <= k < NK; S0[i, j] -> S1[i' = i, j' = j, k = 0] : 0 <= i < NI and 0 <= j < NJ }"
+
@@ -0,0 +1,6 @@
+domain: "[N] -> { S1[i, j] : 0 <= i < N and 0 <= j < N; S3[i, j] : 0 <= i < N and 0 <= j < N; S2[i] : 0 <= i < N; S0[i, j] : 0 <= i < N and 0 <= j < N }"
+context: "[N] -> {  : N >= 2 }"
+validity: "[N] -> { S2[i] -> S3[i', j = i] : 0 <= i < N and 0 <= i' < N; S1[i, j] -> S2[i' = i] : 0 <= i < N and 0 <= j < N; S0[i, j] -> S3[i' = i, j' = j] : 0 <= i < N and 0 <= j < N; S0[i, j] -> S1[i' = j, j' = i] : 0 <= i < N and 0 <= j < N; S1[i, j] -> S1[i' = i, j'] : 0 <= i < N and j >= 0 and j < j' < N; S3[i, j] -> S3[i' = i, j'] : 0 <= i < N and j >= 0 and j < j' < N }"
+coincidence: "[N] -> { S2[i] -> S3[i', j = i] : 0 <= i < N and 0 <= i' < N; S1[i, j] -> S2[i' = i] : 0 <= i < N and 0 <= j < N; S0[i, j] -> S3[i' = i, j' = j] : 0 <= i < N and 0 <= j < N; S0[i, j] -> S1[i' = j, j' = i] : 0 <= i < N and 0 <= j < N; S1[i, j] -> S1[i' = i, j'] : 0 <= i < N and j >= 0 and j < j' < N; S3[i, j] -> S3[i' = i, j'] : 0 <= i < N and j >= 0 and j < j' < N }"
+proximity: "[N] -> { S2[i] -> S3[i', j = i] : 0 <= i < N and 0 <= i' < N; S1[i, j] -> S2[i' = i] : 0 <= i < N and 0 <= j < N; S0[i, j] -> S3[i' = i, j' = j] : 0 <= i < N and 0 <= j < N; S0[i, j] -> S1[i' = j, j' = i] : 0 <= i < N and 0 <= j < N; S1[i, j] -> S1[i' = i, j'] : 0 <= i < N and j >= 0 and j < j' < N; S3[i, j] -> S3[i' = i, j'] : 0 <= i < N and j >= 0 and j < j' < N }"
+
@@ -0,0 +1,6 @@
+domain: "[N, M] -> { IX[i, j] : 0 < i <= -2 + N and 0 < j <= -2 + M; SXY[i, j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; GR[i, j] : 0 <= i < N and 0 <= j < M; XX[i, j] : 0 < i <= -2 + N and 0 < j <= -2 + M; SYY[i, j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IY[i, j] : 0 < i <= -2 + N and 0 < j <= -2 + M; SXX[i, j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; YY[i, j] : 0 < i <= -2 + N and 0 < j <= -2 + M; XY[i, j] : 0 < i <= -2 + N and 0 < j <= -2 + M; H[i, j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M }"
+context: "[N, M] -> {  : N >= 8 and M >= 8 }"
+validity: "[N, M] -> { SXY[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; GR[i, j] -> IY[i', j'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + M; IX[i, j] -> XY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; YY[i, j] -> SYY[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; SYY[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IX[i, j] -> XX[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; SXX[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IY[i, j] -> XY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; XY[i, j] -> SXY[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; XX[i, j] -> SXX[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; IY[i, j] -> YY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; GR[i, j] -> IX[i', j'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + M }"
+coincidence: "[N, M] -> { SXY[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; GR[i, j] -> IY[i', j'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + M; IX[i, j] -> XY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; YY[i, j] -> SYY[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; SYY[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IX[i, j] -> XX[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; SXX[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IY[i, j] -> XY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; XY[i, j] -> SXY[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; XX[i, j] -> SXX[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; IY[i, j] -> YY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; GR[i, j] -> IX[i', j'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + M }"
+proximity: "[N, M] -> { SXY[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; GR[i, j] -> IY[i', j'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + M; IX[i, j] -> XY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; YY[i, j] -> SYY[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; SYY[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IX[i, j] -> XX[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; SXX[i, j] -> H[i' = i, j' = j] : 2 <= i <= -3 + N and 2 <= j <= -3 + M; IY[i, j] -> XY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; XY[i, j] -> SXY[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; XX[i, j] -> SXX[i', j'] : i' >= -1 + i and 2 <= i' <= 1 + i and i' <= -3 + N and j' >= -1 + j and 2 <= j' <= 1 + j and j' <= -3 + M; IY[i, j] -> YY[i' = i, j' = j] : 0 < i <= -2 + N and 0 < j <= -2 + M; GR[i, j] -> IX[i', j'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + M }"
+
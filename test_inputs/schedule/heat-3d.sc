@@ -0,0 +1,6 @@
+domain: "[N, T] -> { U[t, i, j, k] : 0 <= t < T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; S[t, i, j, k] : 0 <= t < T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N }"
+context: "[N, T] -> {  : N >= 4 and T > 0 }"
+validity: "[N, T] -> { S[t, i, j, k] -> U[t' = t, i', j', k'] : 0 <= t < T and ((i > 0 and j > 0 and k > 0 and i <= i' <= -2 + N and j <= j' <= 1 + i + j - i' and j' <= -2 + N and k <= k' <= 1 + j + k - j' and k' <= 1 + i + k - i' and k' <= -2 + N) or (i <= -2 + N and j <= -2 + N and k <= -2 + N and i' > 0 and j' >= -1 + i + j - i' and 0 < j' <= -2 + i + j + k - i' and k' >= -1 + i + k - i' and -1 + j + k - j' <= k' < i + j + k - i' - j')); S[t, i, j, k] -> U[t', i', j' = j, k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; S[t, i, j, k] -> U[t', i' = i, j' = j, k'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and k' >= -1 + k and 0 < k' <= 1 + k and k' <= -2 + N; S[t, i, j, k] -> U[t', i' = i, j', k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N; S[t, i, j, k] -> S[t' = 1 + t, i' = i, j' = j, k' = k] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; U[t, i, j, k] -> U[t' = 1 + t, i' = i, j' = j, k' = k] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; U[t, i, j, k] -> S[t' = 1 + t, i', j', k'] : 0 <= t <= -2 + T and ((i > 0 and j > 0 and k > 0 and i <= i' <= -2 + N and j <= j' <= 1 + i + j - i' and j' <= -2 + N and k <= k' <= 1 + j + k - j' and k' <= 1 + i + k - i' and k' <= -2 + N) or (i <= -2 + N and j <= -2 + N and k <= -2 + N and i' > 0 and j' >= -1 + i + j - i' and 0 < j' <= -2 + i + j + k - i' and k' >= -1 + i + k - i' and -1 + j + k - j' <= k' < i + j + k - i' - j')); U[t, i, j, k] -> S[t', i', j' = j, k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; U[t, i, j, k] -> S[t', i' = i, j' = j, k'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and k' >= -1 + k and 0 < k' <= 1 + k and k' <= -2 + N; U[t, i, j, k] -> S[t', i' = i, j', k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N }"
+coincidence: "[N, T] -> { S[t, i, j, k] -> U[t' = t, i', j', k'] : 0 <= t < T and ((i > 0 and j > 0 and k > 0 and i <= i' <= -2 + N and j <= j' <= 1 + i + j - i' and j' <= -2 + N and k <= k' <= 1 + j + k - j' and k' <= 1 + i + k - i' and k' <= -2 + N) or (i <= -2 + N and j <= -2 + N and k <= -2 + N and i' > 0 and j' >= -1 + i + j - i' and 0 < j' <= -2 + i + j + k - i' and k' >= -1 + i + k - i' and -1 + j + k - j' <= k' < i + j + k - i' - j')); S[t, i, j, k] -> U[t', i', j' = j, k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; S[t, i, j, k] -> U[t', i' = i, j' = j, k'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and k' >= -1 + k and 0 < k' <= 1 + k and k' <= -2 + N; S[t, i, j, k] -> U[t', i' = i, j', k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N; S[t, i, j, k] -> S[t' = 1 + t, i' = i, j' = j, k' = k] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; U[t, i, j, k] -> U[t' = 1 + t, i' = i, j' = j, k' = k] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; U[t, i, j, k] -> S[t' = 1 + t, i', j', k'] : 0 <= t <= -2 + T and ((i > 0 and j > 0 and k > 0 and i <= i' <= -2 + N and j <= j' <= 1 + i + j - i' and j' <= -2 + N and k <= k' <= 1 + j + k - j' and k' <= 1 + i + k - i' and k' <= -2 + N) or (i <= -2 + N and j <= -2 + N and k <= -2 + N and i' > 0 and j' >= -1 + i + j - i' and 0 < j' <= -2 + i + j + k - i' and k' >= -1 + i + k - i' and -1 + j + k - j' <= k' < i + j + k - i' - j')); U[t, i, j, k] -> S[t', i', j' = j, k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; U[t, i, j, k] -> S[t', i' = i, j' = j, k'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and k' >= -1 + k and 0 < k' <= 1 + k and k' <= -2 + N; U[t, i, j, k] -> S[t', i' = i, j', k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N }"
+proximity: "[N, T] -> { S[t, i, j, k] -> U[t' = t, i', j', k'] : 0 <= t < T and ((i > 0 and j > 0 and k > 0 and i <= i' <= -2 + N and j <= j' <= 1 + i + j - i' and j' <= -2 + N and k <= k' <= 1 + j + k - j' and k' <= 1 + i + k - i' and k' <= -2 + N) or (i <= -2 + N and j <= -2 + N and k <= -2 + N and i' > 0 and j' >= -1 + i + j - i' and 0 < j' <= -2 + i + j + k - i' and k' >= -1 + i + k - i' and -1 + j + k - j' <= k' < i + j + k - i' - j')); S[t, i, j, k] -> U[t', i', j' = j, k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; S[t, i, j, k] -> U[t', i' = i, j' = j, k'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and k' >= -1 + k and 0 < k' <= 1 + k and k' <= -2 + N; S[t, i, j, k] -> U[t', i' = i, j', k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t <= t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N; S[t, i, j, k] -> S[t' = 1 + t, i' = i, j' = j, k' = k] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; U[t, i, j, k] -> U[t' = 1 + t, i' = i, j' = j, k' = k] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N; U[t, i, j, k] -> S[t' = 1 + t, i', j', k'] : 0 <= t <= -2 + T and ((i > 0 and j > 0 and k > 0 and i <= i' <= -2 + N and j <= j' <= 1 + i + j - i' and j' <= -2 + N and k <= k' <= 1 + j + k - j' and k' <= 1 + i + k - i' and k' <= -2 + N) or (i <= -2 + N and j <= -2 + N and k <= -2 + N and i' > 0 and j' >= -1 + i + j - i' and 0 < j' <= -2 + i + j + k - i' and k' >= -1 + i + k - i' and -1 + j + k - j' <= k' < i + j + k - i' - j')); U[t, i, j, k] -> S[t', i', j' = j, k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; U[t, i, j, k] -> S[t', i' = i, j' = j, k'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and k' >= -1 + k and 0 < k' <= 1 + k and k' <= -2 + N; U[t, i, j, k] -> S[t', i' = i, j', k' = k] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < k <= -2 + N and t < t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N }"
+
@@ -0,0 +1,6 @@
+domain: "[N, T] -> { S[t, i] : 0 <= t < T and 0 < i <= -2 + N; U[t, i] : 0 <= t < T and 0 < i <= -2 + N }"
+context: "[N, T] -> {  : N >= 4 and T > 0 }"
+validity: "[N, T] -> { U[t, i] -> S[t' = 1 + t, i'] : 0 <= t <= -2 + T and 0 < i <= -2 + N and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; U[t, i] -> S[t', i' = i] : t >= 0 and 0 < i <= -2 + N and t < t' < T; S[t, i] -> U[t', i'] : t >= 0 and 0 < i <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; S[t, i] -> S[t' = 1 + t, i' = i] : 0 <= t <= -2 + T and 0 < i <= -2 + N; U[t, i] -> U[t' = 1 + t, i' = i] : 0 <= t <= -2 + T and 0 < i <= -2 + N }"
+coincidence: "[N, T] -> { U[t, i] -> S[t' = 1 + t, i'] : 0 <= t <= -2 + T and 0 < i <= -2 + N and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; U[t, i] -> S[t', i' = i] : t >= 0 and 0 < i <= -2 + N and t < t' < T; S[t, i] -> U[t', i'] : t >= 0 and 0 < i <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; S[t, i] -> S[t' = 1 + t, i' = i] : 0 <= t <= -2 + T and 0 < i <= -2 + N; U[t, i] -> U[t' = 1 + t, i' = i] : 0 <= t <= -2 + T and 0 < i <= -2 + N }"
+proximity: "[N, T] -> { U[t, i] -> S[t' = 1 + t, i'] : 0 <= t <= -2 + T and 0 < i <= -2 + N and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; U[t, i] -> S[t', i' = i] : t >= 0 and 0 < i <= -2 + N and t < t' < T; S[t, i] -> U[t', i'] : t >= 0 and 0 < i <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; S[t, i] -> S[t' = 1 + t, i' = i] : 0 <= t <= -2 + T and 0 < i <= -2 + N; U[t, i] -> U[t' = 1 + t, i' = i] : 0 <= t <= -2 + T and 0 < i <= -2 + N }"
+
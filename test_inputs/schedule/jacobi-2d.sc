@@ -0,0 +1,6 @@
+domain: "[N, T] -> { S[t, i, j] : 0 <= t < T and 0 < i <= -2 + N and 0 < j <= -2 + N; U[t, i, j] : 0 <= t < T and 0 < i <= -2 + N and 0 < j <= -2 + N }"
+context: "[N, T] -> {  : N >= 4 and T > 0 }"
+validity: "[N, T] -> { U[t, i, j] -> U[t' = 1 + t, i' = i, j' = j] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N; U[t, i, j] -> S[t' = 1 + t, i', j'] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < i' <= -2 + N and j' >= -1 + i + j - i' and j' > 0 and -1 - i + j + i' <= j' <= 1 - i + j + i' and j' <= 1 + i + j - i' and j' <= -2 + N; U[t, i, j] -> S[t', i' = i, j' = j] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t < t' < T; S[t, i, j] -> S[t' = 1 + t, i' = i, j' = j] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N; S[t, i, j] -> U[t', i' = i, j'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t <= t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N; S[t, i, j] -> U[t', i', j' = j] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N }"
+coincidence: "[N, T] -> { U[t, i, j] -> U[t' = 1 + t, i' = i, j' = j] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N; U[t, i, j] -> S[t' = 1 + t, i', j'] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < i' <= -2 + N and j' >= -1 + i + j - i' and j' > 0 and -1 - i + j + i' <= j' <= 1 - i + j + i' and j' <= 1 + i + j - i' and j' <= -2 + N; U[t, i, j] -> S[t', i' = i, j' = j] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t < t' < T; S[t, i, j] -> S[t' = 1 + t, i' = i, j' = j] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N; S[t, i, j] -> U[t', i' = i, j'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t <= t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N; S[t, i, j] -> U[t', i', j' = j] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N }"
+proximity: "[N, T] -> { U[t, i, j] -> U[t' = 1 + t, i' = i, j' = j] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N; U[t, i, j] -> S[t' = 1 + t, i', j'] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N and 0 < i' <= -2 + N and j' >= -1 + i + j - i' and j' > 0 and -1 - i + j + i' <= j' <= 1 - i + j + i' and j' <= 1 + i + j - i' and j' <= -2 + N; U[t, i, j] -> S[t', i' = i, j' = j] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t < t' < T; S[t, i, j] -> S[t' = 1 + t, i' = i, j' = j] : 0 <= t <= -2 + T and 0 < i <= -2 + N and 0 < j <= -2 + N; S[t, i, j] -> U[t', i' = i, j'] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t <= t' < T and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N; S[t, i, j] -> U[t', i', j' = j] : t >= 0 and 0 < i <= -2 + N and 0 < j <= -2 + N and t <= t' < T and i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N }"
+
@@ -0,0 +1,6 @@
+domain: "[N] -> { S0[i, j, k] : i < N and j < i and 0 <= k < j; S2[i, j, k] : i <= j < N and 0 <= k < i; S1[i, j] : i < N and 0 <= j < i }"
+context: "[N] -> {  : N >= 2 }"
+validity: "[N] -> { S0[i, j, k] -> S1[i' = i, j' = j] : i < N and j < i and 0 <= k < j; S2[i, j = i, k = -1 + i] -> S1[i', j' = i] : i > 0 and i < i' < N; S2[i, j, k] -> S2[i' = i, j' = j, k'] : i <= j < N and k >= 0 and k < k' < i; S2[i, j, k = -1 + i] -> S2[i', j' = j, k' = i] : i > 0 and j < N and i < i' <= j; S0[i, j, k] -> S0[i' = i, j' = j, k'] : i < N and j < i and k >= 0 and k < k' < j; S1[i, j] -> S0[i' = i, j', k = j] : i < N and j >= 0 and j < j' < i; S2[i, j, k = -1 + i] -> S0[i', j' = j, k' = i] : i > 0 and j > i and j < i' < N; S1[i, j] -> S2[i' = i, j', k = j] : 0 <= j < i and i <= j' < N }"
+coincidence: "[N] -> { S0[i, j, k] -> S1[i' = i, j' = j] : i < N and j < i and 0 <= k < j; S2[i, j = i, k = -1 + i] -> S1[i', j' = i] : i > 0 and i < i' < N; S2[i, j, k] -> S2[i' = i, j' = j, k'] : i <= j < N and k >= 0 and k < k' < i; S2[i, j, k = -1 + i] -> S2[i', j' = j, k' = i] : i > 0 and j < N and i < i' <= j; S0[i, j, k] -> S0[i' = i, j' = j, k'] : i < N and j < i and k >= 0 and k < k' < j; S1[i, j] -> S0[i' = i, j', k = j] : i < N and j >= 0 and j < j' < i; S2[i, j, k = -1 + i] -> S0[i', j' = j, k' = i] : i > 0 and j > i and j < i' < N; S1[i, j] -> S2[i' = i, j', k = j] : 0 <= j < i and i <= j' < N }"
+proximity: "[N] -> { S0[i, j, k] -> S1[i' = i, j' = j] : i < N and j < i and 0 <= k < j; S2[i, j = i, k = -1 + i] -> S1[i', j' = i] : i > 0 and i < i' < N; S2[i, j, k] -> S2[i' = i, j' = j, k'] : i <= j < N and k >= 0 and k < k' < i; S2[i, j, k = -1 + i] -> S2[i', j' = j, k' = i] : i > 0 and j < N and i < i' <= j; S0[i, j, k] -> S0[i' = i, j' = j, k'] : i < N and j < i and k >= 0 and k < k' < j; S1[i, j] -> S0[i' = i, j', k = j] : i < N and j >= 0 and j < j' < i; S2[i, j, k = -1 + i] -> S0[i', j' = j, k' = i] : i > 0 and j > i and j < i' < N; S1[i, j] -> S2[i' = i, j', k = j] : 0 <= j < i and i <= j' < N }"
+
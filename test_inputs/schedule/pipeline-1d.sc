@@ -0,0 +1,6 @@
+domain: "[N] -> { P5[i] : 5 <= i <= -6 + N; P9[i] : 9 <= i <= -10 + N; P8[i] : 8 <= i <= -9 + N; P3[i] : 3 <= i <= -4 + N; P0[i] : 0 <= i < N; P1[i] : 0 < i <= -2 + N; P4[i] : 4 <= i <= -5 + N; P10[i] : 10 <= i <= -11 + N; P2[i] : 2 <= i <= -3 + N; P11[i] : 11 <= i <= -12 + N; P6[i] : 6 <= i <= -7 + N; P7[i] : 7 <= i <= -8 + N }"
+context: "[N] -> {  : N >= 32 }"
+validity: "[N] -> { P7[i] -> P10[i' = i] : 10 <= i <= -11 + N; P6[i] -> P7[i'] : i' >= -1 + i and 7 <= i' <= 1 + i and i' <= -8 + N; P5[i] -> P6[i' = i] : 6 <= i <= -7 + N; P1[i] -> P4[i' = i] : 4 <= i <= -5 + N; P3[i] -> P6[i' = i] : 6 <= i <= -7 + N; P4[i] -> P5[i'] : i' >= -1 + i and 5 <= i' <= 1 + i and i' <= -6 + N; P5[i] -> P8[i' = i] : 8 <= i <= -9 + N; P9[i] -> P10[i' = i] : 10 <= i <= -11 + N; P8[i] -> P9[i'] : i' >= -1 + i and 9 <= i' <= 1 + i and i' <= -10 + N; P3[i] -> P4[i' = i] : 4 <= i <= -5 + N; P0[i] -> P1[i'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; P1[i] -> P2[i' = i] : 2 <= i <= -3 + N; P7[i] -> P8[i' = i] : 8 <= i <= -9 + N; P2[i] -> P3[i'] : i' >= -1 + i and 3 <= i' <= 1 + i and i' <= -4 + N; P10[i] -> P11[i'] : i' >= -1 + i and 11 <= i' <= 1 + i and i' <= -12 + N }"
+coincidence: "[N] -> { P7[i] -> P10[i' = i] : 10 <= i <= -11 + N; P6[i] -> P7[i'] : i' >= -1 + i and 7 <= i' <= 1 + i and i' <= -8 + N; P5[i] -> P6[i' = i] : 6 <= i <= -7 + N; P1[i] -> P4[i' = i] : 4 <= i <= -5 + N; P3[i] -> P6[i' = i] : 6 <= i <= -7 + N; P4[i] -> P5[i'] : i' >= -1 + i and 5 <= i' <= 1 + i and i' <= -6 + N; P5[i] -> P8[i' = i] : 8 <= i <= -9 + N; P9[i] -> P10[i' = i] : 10 <= i <= -11 + N; P8[i] -> P9[i'] : i' >= -1 + i and 9 <= i' <= 1 + i and i' <= -10 + N; P3[i] -> P4[i' = i] : 4 <= i <= -5 + N; P0[i] -> P1[i'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; P1[i] -> P2[i' = i] : 2 <= i <= -3 + N; P7[i] -> P8[i' = i] : 8 <= i <= -9 + N; P2[i] -> P3[i'] : i' >= -1 + i and 3 <= i' <= 1 + i and i' <= -4 + N; P10[i] -> P11[i'] : i' >= -1 + i and 11 <= i' <= 1 + i and i' <= -12 + N }"
+proximity: "[N] -> { P7[i] -> P10[i' = i] : 10 <= i <= -11 + N; P6[i] -> P7[i'] : i' >= -1 + i and 7 <= i' <= 1 + i and i' <= -8 + N; P5[i] -> P6[i' = i] : 6 <= i <= -7 + N; P1[i] -> P4[i' = i] : 4 <= i <= -5 + N; P3[i] -> P6[i' = i] : 6 <= i <= -7 + N; P4[i] -> P5[i'] : i' >= -1 + i and 5 <= i' <= 1 + i and i' <= -6 + N; P5[i] -> P8[i' = i] : 8 <= i <= -9 + N; P9[i] -> P10[i' = i] : 10 <= i <= -11 + N; P8[i] -> P9[i'] : i' >= -1 + i and 9 <= i' <= 1 + i and i' <= -10 + N; P3[i] -> P4[i' = i] : 4 <= i <= -5 + N; P0[i] -> P1[i'] : i' >= -1 + i and 0 < i' <= 1 + i and i' <= -2 + N; P1[i] -> P2[i' = i] : 2 <= i <= -3 + N; P7[i] -> P8[i' = i] : 8 <= i <= -9 + N; P2[i] -> P3[i'] : i' >= -1 + i and 3 <= i' <= 1 + i and i' <= -4 + N; P10[i] -> P11[i'] : i' >= -1 + i and 11 <= i' <= 1 + i and i' <= -12 + N }"
+
@@ -0,0 +1,6 @@
+domain: "[N, T] -> { S[t, i, j] : 0 <= t < T and 0 < i <= -2 + N and 0 < j <= -2 + N }"
+context: "[N, T] -> {  : N >= 4 and T > 0 }"
+validity: "[N, T] -> { S[t, i, j] -> S[t', i', j'] : t >= 0 and i <= -2 + N and j > 0 and t' < T and i' > 0 and ((i > 0 and j <= -2 + N and t' > t and -1 + i <= i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N) or (t' >= 3 - N + t + j and i' >= t + i - t' and i' >= 2 - N + i + j and j' > t + j - t' and i + j - i' <= j' <= 1 + t + i + j - t' - i')); S[t, i, j] -> S[t' = t, i' = 1 + i, j'] : 0 <= t < T and 0 < i <= -3 + N and 0 < j <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N }"
+coincidence: "[N, T] -> { S[t, i, j] -> S[t', i', j'] : t >= 0 and i <= -2 + N and j > 0 and t' < T and i' > 0 and ((i > 0 and j <= -2 + N and t' > t and -1 + i <= i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N) or (t' >= 3 - N + t + j and i' >= t + i - t' and i' >= 2 - N + i + j and j' > t + j - t' and i + j - i' <= j' <= 1 + t + i + j - t' - i')); S[t, i, j] -> S[t' = t, i' = 1 + i, j'] : 0 <= t < T and 0 < i <= -3 + N and 0 < j <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N }"
+proximity: "[N, T] -> { S[t, i, j] -> S[t', i', j'] : t >= 0 and i <= -2 + N and j > 0 and t' < T and i' > 0 and ((i > 0 and j <= -2 + N and t' > t and -1 + i <= i' <= 1 + i and i' <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N) or (t' >= 3 - N + t + j and i' >= t + i - t' and i' >= 2 - N + i + j and j' > t + j - t' and i + j - i' <= j' <= 1 + t + i + j - t' - i')); S[t, i, j] -> S[t' = t, i' = 1 + i, j'] : 0 <= t < T and 0 < i <= -3 + N and 0 < j <= -2 + N and j' >= -1 + j and 0 < j' <= 1 + j and j' <= -2 + N }"
+
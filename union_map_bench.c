@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <isl/ctx.h>
+#include <isl/map.h>
+#include <isl/union_map.h>
+
+/* The default number of statements.
+ */
+#define N_STATEMENTS	2000
+
+/* Construct a union map with a map { A<i>[i] -> B<i>[i] : 0 <= i < 10 }
+ * for each i in [0, n), where A and B are replaced by "dom" and "ran".
+ */
+static __isl_give isl_union_map *chain(isl_ctx *ctx, int n,
+	const char *dom, const char *ran)
+{
+	int i;
+	char buffer[100];
+	isl_union_map *umap;
+
+	umap = isl_union_map_empty(isl_space_params_alloc(ctx, 0));
+	for (i = 0; i < n; ++i) {
+		isl_map *map;
+
+		snprintf(buffer, sizeof(buffer),
+			"{ %s%d[i] -> %s%d[i] : 0 <= i < 10 }",
+			dom, i, ran, i);
+		map = isl_map_read_from_str(ctx, buffer);
+		umap = isl_union_map_add_map(umap, map);
+	}
+
+	return umap;
+}
+
+/* Construct a list of maps { S<i>[i] -> [i] : 0 <= i < 10 } and
+ * [n] -> { S<i>[i] -> [i] : i >= n } for each i in [0, n).
+ */
+static __isl_give isl_map_list *access_list(isl_ctx *ctx, int n)
+{
+	int i;
+	char buffer[100];
+	isl_map_list *list;
+
+	list = isl_map_list_alloc(ctx, 2 * n);
+	for (i = 0; i < n; ++i) {
+		isl_map *map;
+
+		snprintf(buffer, sizeof(buffer),
+			"{ S%d[i] -> [i] : 0 <= i < 10 }", i);
+		map = isl_map_read_from_str(ctx, buffer);
+		list = isl_map_list_add(list, map);
+		snprintf(buffer, sizeof(buffer),
+			"[n] -> { S%d[i] -> [i] : i >= n }", i);
+		map = isl_map_read_from_str(ctx, buffer);
+		list = isl_map_list_add(list, map);
+	}
+
+	return list;
+}
+
+/* Construct a union map from the elements of "list",
+ * by adding them one by one.
+ */
+static __isl_give isl_union_map *add_maps(__isl_keep isl_map_list *list)
+{
+	int i, n;
+	isl_union_map *umap;
+
+	n = isl_map_list_n_map(list);
+	umap = isl_union_map_empty(
+			isl_space_params_alloc(isl_map_list_get_ctx(list), 0));
+	for (i = 0; i < n; ++i)
+		umap = isl_union_map_add_map(umap,
+					    isl_map_list_get_map(list, i));
+
+	return umap;
+}
+
+/* Print the time it takes to construct a union map
+ * from the elements of "list", both by adding them one by one and
+ * by calling isl_union_map_from_map_list.
+ */
+static int bench_build(__isl_keep isl_map_list *list)
+{
+	isl_union_map *umap1, *umap2;
+	clock_t start, mid, end;
+
+	start = clock();
+	umap1 = add_maps(list);
+	mid = clock();
+	umap2 = isl_union_map_from_map_list(isl_map_list_copy(list));
+	end = clock();
+	isl_union_map_free(umap1);
+	isl_union_map_free(umap2);
+	if (!umap1 || !umap2)
+		return -1;
+
+	printf("add_map: %.3f ms\n", 1000.0 * (mid - start) / CLOCKS_PER_SEC);
+	printf("from_map_list: %.3f ms\n",
+		1000.0 * (end - mid) / CLOCKS_PER_SEC);
+
+	return 0;
+}
+
+/* Apply "fn" to copies of "umap1" and "umap2" and print the time
+ * it took together with the number of maps in the result.
+ */
+static int bench(const char *name, __isl_keep isl_union_map *umap1,
+	__isl_keep isl_union_map *umap2,
+	__isl_give isl_union_map *(*fn)(__isl_take isl_union_map *umap1,
+		__isl_take isl_union_map *umap2))
+{
+	isl_union_map *res;
+	clock_t start, end;
+	int n;
+
+	start = clock();
+	res = fn(isl_union_map_copy(umap1), isl_union_map_copy(umap2));
+	end = clock();
+	n = isl_union_map_n_map(res);
+	isl_union_map_free(res);
+	if (!res)
+		return -1;
+
+	printf("%s: %.3f ms, %d maps\n", name,
+		1000.0 * (end - start) / CLOCKS_PER_SEC, n);
+
+	return 0;
+}
+
+/* Report the latency of binary operations on union maps that
+ * only combine maps with matching tuples and of the construction
+ * of union maps from lists of maps, on inputs with
+ * a given number of statements (default N_STATEMENTS), e.g.,
+ *
+ *	isl_union_map_bench 5000
+ */
+int main(int argc, char **argv)
+{
+	int n = N_STATEMENTS;
+	int r = 0;
+	isl_ctx *ctx;
+	isl_union_map *s_to_t, *t_to_u, *s_to_u;
+	isl_map_list *list;
+
+	if (argc > 1)
+		n = atoi(argv[1]);
+
+	ctx = isl_ctx_alloc();
+	s_to_t = chain(ctx, n, "S", "T");
+	t_to_u = chain(ctx, n, "T", "U");
+	s_to_u = chain(ctx, n, "S", "U");
+
+	if (bench("apply_range", s_to_t, t_to_u,
+		    &isl_union_map_apply_range) < 0)
+		r = 1;
+	if (bench("apply_domain", s_to_u, s_to_t,
+		    &isl_union_map_apply_domain) < 0)
+		r = 1;
+	if (bench("range_product", s_to_t, s_to_u,
+		    &isl_union_map_range_product) < 0)
+		r = 1;
+	if (bench("domain_product", s_to_u, t_to_u,
+		    &isl_union_map_domain_product) < 0)
+		r = 1;
+	if (bench("lex_lt", s_to_u, t_to_u,
+		    &isl_union_map_lex_lt_union_map) < 0)
+		r = 1;
+
+	list = access_list(ctx, n);
+	if (bench_build(list) < 0)
+		r = 1;
+	isl_map_list_free(list);
+
+	isl_union_map_free(s_to_t);
+	isl_union_map_free(t_to_u);
+	isl_union_map_free(s_to_u);
+	isl_ctx_free(ctx);
+
+	return r;
+}